@@ -0,0 +1,32 @@
+// File: include/key_util.h
+// Parses the 16-byte ESP-NOW keys (PMK/LMK) typed on a serial console.
+#pragma once
+
+#include <stdint.h>
+#include <string.h>
+#include <ctype.h>
+
+#define KEY_LEN 16
+
+// Expects exactly 32 hex digits, no separators
+inline bool parseKey(const char *text, uint8_t *key)
+{
+    if (text == NULL || strlen(text) != KEY_LEN * 2)
+        return false;
+    for (int i = 0; i < KEY_LEN * 2; i++)
+    {
+        char c = text[i];
+        int v;
+        if (c >= '0' && c <= '9')
+            v = c - '0';
+        else if (tolower(c) >= 'a' && tolower(c) <= 'f')
+            v = tolower(c) - 'a' + 10;
+        else
+            return false;
+        if (i % 2 == 0)
+            key[i / 2] = v << 4;
+        else
+            key[i / 2] |= v;
+    }
+    return true;
+}
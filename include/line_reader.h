@@ -0,0 +1,220 @@
+// File: include/line_reader.h
+// Incremental line editor for serial consoles, in fixed memory.
+// lineReaderPoll() takes whatever bytes are waiting and returns as soon
+// as a line is complete, so it never blocks and never allocates.
+// Backspace/DEL erase, Ctrl-U clears the line, Up/Down arrows (or
+// Ctrl-P/Ctrl-N) walk the history. A line longer than N - 1 characters
+// is discarded on Enter, with an error echo, rather than returned cut.
+//
+// Only needs available()/read() on the input and write(uint8_t) on the
+// echo, so it builds on the host against a fake stream too.
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#define LINE_CTRL_N 0x0E
+#define LINE_CTRL_P 0x10
+#define LINE_CTRL_U 0x15
+#define LINE_ESC 0x1B
+
+template <size_t N, size_t H>
+struct line_reader_t
+{
+    static_assert(N >= 2 && H >= 1, "line_reader_t needs room for a line and one history entry");
+
+    char buf[N];
+    size_t len;
+    bool ready; // buf holds the line returned last time
+    bool echo;
+
+    char history[H][N];
+    size_t histCount; // entries stored
+    size_t histNext;  // slot the next entry goes to
+    size_t browse;    // 0 = new line, k = k-th most recent entry
+    char scratch[N];  // the line being typed while browsing the history
+
+    uint8_t esc; // 0, or 1/2 while inside an ESC [ sequence
+    bool lastCR; // swallow the LF of a CR LF pair
+    bool overflowed; // characters were dropped from this line
+    uint32_t overflows; // lines discarded as too long
+};
+
+template <size_t N, size_t H>
+void lineReaderInit(line_reader_t<N, H> *r, bool echo)
+{
+    memset(r, 0, sizeof(*r));
+    r->echo = echo;
+}
+
+template <typename E>
+void lineEcho(E *out, const char *text)
+{
+    while (*text != '\0')
+        out->write((uint8_t)*text++);
+}
+
+// Replaces what is on the line with text, on screen too
+template <size_t N, size_t H, typename E>
+void lineReplace(line_reader_t<N, H> *r, const char *text, E *out)
+{
+    if (r->echo && out != NULL)
+        for (size_t i = 0; i < r->len; i++)
+            lineEcho(out, "\b \b");
+    strncpy(r->buf, text, N - 1);
+    r->buf[N - 1] = '\0';
+    r->len = strlen(r->buf);
+    r->overflowed = false;
+    if (r->echo && out != NULL)
+        lineEcho(out, r->buf);
+}
+
+template <size_t N, size_t H, typename E>
+void lineBrowse(line_reader_t<N, H> *r, bool older, E *out)
+{
+    if (older && r->browse < r->histCount)
+    {
+        if (r->browse == 0)
+        {
+            memcpy(r->scratch, r->buf, r->len);
+            r->scratch[r->len] = '\0';
+        }
+        r->browse++;
+    }
+    else if (!older && r->browse > 0)
+        r->browse--;
+    else
+        return;
+
+    if (r->browse == 0)
+        lineReplace(r, r->scratch, out);
+    else
+        lineReplace(r, r->history[(r->histNext + H - r->browse) % H], out);
+}
+
+// Strips surrounding blanks and stores the line in the history
+template <size_t N, size_t H>
+bool lineFinish(line_reader_t<N, H> *r)
+{
+    r->buf[r->len] = '\0';
+    size_t start = strspn(r->buf, " \t");
+    size_t end = r->len;
+    while (end > start && (r->buf[end - 1] == ' ' || r->buf[end - 1] == '\t'))
+        end--;
+    memmove(r->buf, r->buf + start, end - start);
+    r->len = end - start;
+    r->buf[r->len] = '\0';
+    r->browse = 0;
+    if (r->len == 0)
+        return false;
+
+    const char *latest = r->histCount ? r->history[(r->histNext + H - 1) % H] : "";
+    if (strcmp(latest, r->buf) != 0)
+    {
+        memcpy(r->history[r->histNext], r->buf, r->len + 1);
+        r->histNext = (r->histNext + 1) % H;
+        if (r->histCount < H)
+            r->histCount++;
+    }
+    return true;
+}
+
+// Returns the finished line (valid until the next call), or NULL if no
+// complete line is waiting yet. Blank lines are swallowed.
+template <size_t N, size_t H, typename S, typename E>
+const char *lineReaderPoll(line_reader_t<N, H> *r, S &in, E *out)
+{
+    if (r->ready)
+    {
+        r->ready = false;
+        r->len = 0;
+    }
+    if (!r->echo)
+        out = NULL;
+
+    while (in.available() > 0)
+    {
+        int c = in.read();
+        if (c < 0)
+            break;
+
+        if (r->esc == 1)
+        {
+            r->esc = (c == '[') ? 2 : 0;
+            continue;
+        }
+        if (r->esc == 2)
+        {
+            // Parameters run until the final byte 0x40..0x7E
+            if (c >= 0x40 && c <= 0x7E)
+            {
+                r->esc = 0;
+                if (c == 'A' || c == 'B')
+                    lineBrowse(r, c == 'A', out);
+            }
+            continue;
+        }
+
+        bool wasCR = r->lastCR;
+        r->lastCR = c == '\r';
+        if (c == '\n' && wasCR)
+            continue;
+
+        if (c == '\r' || c == '\n')
+        {
+            if (out != NULL)
+                lineEcho(out, "\r\n");
+            if (r->overflowed)
+            {
+                if (out != NULL)
+                    lineEcho(out, "Error: line too long, discarded\r\n");
+                r->overflowed = false;
+                r->browse = 0;
+            }
+            else if (lineFinish(r))
+            {
+                r->ready = true;
+                return r->buf;
+            }
+            r->len = 0;
+        }
+        else if (c == '\b' || c == 0x7F)
+        {
+            if (r->len > 0)
+            {
+                r->len--;
+                if (out != NULL)
+                    lineEcho(out, "\b \b");
+            }
+        }
+        else if (c == LINE_CTRL_U)
+        {
+            lineReplace(r, "", out);
+        }
+        else if (c == LINE_CTRL_P || c == LINE_CTRL_N)
+        {
+            lineBrowse(r, c == LINE_CTRL_P, out);
+        }
+        else if (c == LINE_ESC)
+        {
+            r->esc = 1;
+        }
+        else if (c >= 0x20 && c < 0x7F)
+        {
+            if (r->len < N - 1)
+            {
+                r->buf[r->len++] = (char)c;
+                if (out != NULL)
+                    out->write((uint8_t)c);
+            }
+            else
+            {
+                if (!r->overflowed)
+                    r->overflows++;
+                r->overflowed = true;
+            }
+        }
+    }
+    return NULL;
+}
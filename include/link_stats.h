@@ -0,0 +1,185 @@
+// File: include/link_stats.h
+// ESP-NOW link-quality counters, shared by the Remote and the Hub.
+// Each firmware keeps a fixed array of link_stats_t (one per peer) and
+// serialises access with its own lock; nothing here allocates.
+#pragma once
+
+#include <Arduino.h>
+#include <esp_wifi.h>
+#include "mac_util.h"
+
+#define LINK_RSSI_NONE -128
+#define LINK_RSSI_EWMA_SHIFT 3 // average over ~8 frames
+
+typedef struct link_stats_t
+{
+    uint8_t mac[6];
+    bool used;
+    uint32_t lastRxMs;
+
+    // Frames
+    uint32_t rxFrames;
+    uint32_t rxDuplicates;
+    uint32_t rxGaps; // sequence numbers never seen
+    uint32_t rxLate; // arrived after a higher seq
+    uint32_t sessions;
+    uint32_t txOk;
+    uint32_t txFail;
+
+    // Sequence tracking
+    bool seqValid;
+    uint32_t session;
+    uint32_t lastSeq;
+
+    // Signal, from the promiscuous callback
+    uint32_t rssiSamples;
+    int8_t rssiLast;
+    int8_t rssiMin;
+    int8_t rssiMax;
+    int16_t rssiAvgQ4; // EWMA in 1/16 dBm
+} link_stats_t;
+
+inline void linkReset(link_stats_t *l, const uint8_t *mac)
+{
+    memset(l, 0, sizeof(*l));
+    memcpy(l->mac, mac, 6);
+    l->used = true;
+    l->rssiLast = LINK_RSSI_NONE;
+    l->rssiMin = 127;
+    l->rssiMax = LINK_RSSI_NONE;
+}
+
+// Finds mac in the table. With create set, a missing entry takes a free
+// slot, or the one heard from longest ago.
+inline link_stats_t *linkFind(link_stats_t *table, size_t count, const uint8_t *mac, bool create)
+{
+    link_stats_t *victim = NULL;
+    for (size_t i = 0; i < count; i++)
+    {
+        link_stats_t *l = &table[i];
+        if (l->used && memcmp(l->mac, mac, 6) == 0)
+            return l;
+        if (victim != NULL && !victim->used)
+            continue; // already have a free slot
+        if (!l->used || victim == NULL || (int32_t)(l->lastRxMs - victim->lastRxMs) < 0)
+            victim = l;
+    }
+    if (!create || victim == NULL)
+        return NULL;
+    linkReset(victim, mac);
+    return victim;
+}
+
+inline void linkOnRssi(link_stats_t *l, int8_t rssi)
+{
+    if (l->rssiSamples == 0)
+        l->rssiAvgQ4 = rssi * 16;
+    else
+        l->rssiAvgQ4 += (rssi * 16 - l->rssiAvgQ4) >> LINK_RSSI_EWMA_SHIFT;
+    l->rssiSamples++;
+    l->rssiLast = rssi;
+    if (rssi < l->rssiMin)
+        l->rssiMin = rssi;
+    if (rssi > l->rssiMax)
+        l->rssiMax = rssi;
+}
+
+// Counts a received frame that carries no sequence of its own (ACKs)
+inline void linkOnRx(link_stats_t *l)
+{
+    l->rxFrames++;
+    l->lastRxMs = millis();
+}
+
+// Counts one received frame. duplicate comes from the caller's dedup
+// window; without one, pass false and repeats count as late.
+inline void linkOnFrame(link_stats_t *l, uint32_t session, uint32_t seq, bool duplicate)
+{
+    linkOnRx(l);
+    if (duplicate)
+    {
+        l->rxDuplicates++;
+        return;
+    }
+    if (!l->seqValid || session != l->session)
+    {
+        // New boot on the other side: start counting gaps afresh
+        l->seqValid = true;
+        l->session = session;
+        l->lastSeq = seq;
+        l->sessions++;
+        return;
+    }
+    if (seq > l->lastSeq)
+    {
+        l->rxGaps += seq - l->lastSeq - 1;
+        l->lastSeq = seq;
+    }
+    else
+    {
+        l->rxLate++;
+        if (l->rxGaps > 0)
+            l->rxGaps--; // it was not lost after all
+    }
+}
+
+inline void linkOnSent(link_stats_t *l, bool ok)
+{
+    if (ok)
+        l->txOk++;
+    else
+        l->txFail++;
+}
+
+// Frames lost per thousand, receive gaps and failed sends together
+inline uint16_t linkLossPermille(const link_stats_t *l)
+{
+    uint32_t expected = l->rxFrames - l->rxDuplicates + l->rxGaps + l->txOk + l->txFail;
+    uint32_t lost = l->rxGaps + l->txFail;
+    return expected ? (uint16_t)((uint64_t)lost * 1000 / expected) : 0;
+}
+
+inline int8_t linkRssiAvg(const link_stats_t *l)
+{
+    if (l->rssiSamples == 0)
+        return LINK_RSSI_NONE;
+    return (int8_t)(l->rssiAvgQ4 / 16);
+}
+
+inline void linkPrint(Print &out, const link_stats_t *l)
+{
+    out.printf("  " MAC_FMT "  heard %u ms ago\n", MAC_ARGS(l->mac), (unsigned)(millis() - l->lastRxMs));
+    out.printf("    rx %u, dup %u, gaps %u, late %u, sessions %u | tx ok %u, fail %u | loss %.1f %%\n",
+               (unsigned)l->rxFrames, (unsigned)l->rxDuplicates, (unsigned)l->rxGaps, (unsigned)l->rxLate,
+               (unsigned)l->sessions, (unsigned)l->txOk, (unsigned)l->txFail, linkLossPermille(l) / 10.0f);
+    if (l->rssiSamples == 0)
+        out.println("    RSSI: no samples");
+    else
+        out.printf("    RSSI avg %d dBm, last %d, min %d, max %d (%u samples)\n", linkRssiAvg(l), l->rssiLast,
+                   l->rssiMin, l->rssiMax, (unsigned)l->rssiSamples);
+}
+
+// Picks the sender and RSSI out of a promiscuous-mode frame if it is an
+// ESP-NOW frame (vendor-specific action frame with Espressif's OUI).
+inline bool linkParseEspNow(const void *buf, wifi_promiscuous_pkt_type_t type, const uint8_t **mac, int8_t *rssi)
+{
+    if (type != WIFI_PKT_MGMT)
+        return false;
+    const wifi_promiscuous_pkt_t *pkt = (const wifi_promiscuous_pkt_t *)buf;
+    const uint8_t *p = pkt->payload;
+    if (pkt->rx_ctrl.sig_len < 28 || p[0] != 0xD0 || p[24] != 0x7F ||
+        p[25] != 0x18 || p[26] != 0xFE || p[27] != 0x34)
+        return false;
+    *mac = p + 10; // addr2, the transmitter
+    *rssi = (int8_t)pkt->rx_ctrl.rssi;
+    return true;
+}
+
+inline void linkEnableRssi(wifi_promiscuous_cb_t cb)
+{
+    wifi_promiscuous_filter_t filter;
+    filter.filter_mask = WIFI_PROMIS_FILTER_MASK_MGMT;
+    esp_wifi_set_promiscuous_filter(&filter);
+    esp_wifi_set_promiscuous_rx_cb(cb);
+    esp_wifi_set_promiscuous(true);
+}
@@ -0,0 +1,24 @@
+// File: include/mac_util.h
+// Helpers for MAC addresses typed on, or printed to, a serial console.
+#pragma once
+
+#include <stdint.h>
+#include <stdio.h>
+
+#define MAC_FMT "%02X:%02X:%02X:%02X:%02X:%02X"
+#define MAC_ARGS(m) (m)[0], (m)[1], (m)[2], (m)[3], (m)[4], (m)[5]
+
+// Accepts "AA:BB:CC:DD:EE:FF" (or '-' separated), any case
+inline bool parseMac(const char *text, uint8_t *mac)
+{
+    unsigned int b[6];
+    char tail;
+    if (text == NULL)
+        return false;
+    if (sscanf(text, "%2x:%2x:%2x:%2x:%2x:%2x%c", &b[0], &b[1], &b[2], &b[3], &b[4], &b[5], &tail) != 6 &&
+        sscanf(text, "%2x-%2x-%2x-%2x-%2x-%2x%c", &b[0], &b[1], &b[2], &b[3], &b[4], &b[5], &tail) != 6)
+        return false;
+    for (int i = 0; i < 6; i++)
+        mac[i] = (uint8_t)b[i];
+    return true;
+}
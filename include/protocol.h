@@ -0,0 +1,172 @@
+// File: include/protocol.h
+// ESP-NOW message layout shared by the Remote and the Hub.
+// Both firmwares must be built from the same version of this file.
+#pragma once
+
+#include <stdint.h>
+
+#define PROTOCOL_VERSION 1
+#define ESPNOW_MAX_PAYLOAD 250
+
+// --- MESSAGE TYPES ---
+#define MSG_COMMAND 0x01
+#define MSG_ACK 0x02
+#define MSG_BENCH_PING 0x03
+#define MSG_BENCH_PONG 0x04
+#define MSG_BATCH 0x05
+#define MSG_BATCH_ACK 0x06
+#define MSG_TELEMETRY 0x07
+#define MSG_PAIR_BEACON 0x08  // hub -> broadcast while pairing is open
+#define MSG_PAIR_REQUEST 0x09 // remote -> hub
+#define MSG_PAIR_ACCEPT 0x0A  // hub -> remote
+
+// --- ACK STATUS ---
+#define ACK_OK 0
+#define ACK_DUPLICATE 1 // retransmit, already executed earlier
+#define ACK_UNKNOWN 2   // command not recognised
+#define ACK_DENIED 3    // sender is a read-only peer
+#define ACK_SKIPPED 4   // batch op not run (atomic batch rejected)
+#define ACK_BUSY 5      // another batch is still running
+#define ACK_LOCKOUT 6   // pump is resting after its last run
+#define ACK_INTERLOCK 7 // would open more zones than the hub allows
+#define ACK_TOO_LONG 8  // run longer than the hub's maximum runtime
+
+// --- ROLES ---
+// Granted by the hub per remote, reported back when pairing
+#define ROLE_CONTROL 1   // may switch the pump
+#define ROLE_READ_ONLY 2 // gets ACKs and telemetry, commands are refused
+
+// --- BATCH OPCODES ---
+// target is a zone bitmask (bit 0 = zone 1); 0 means the hub's default zone.
+#define OP_PUMP_ON 0x01
+#define OP_PUMP_OFF 0x02
+#define OP_TOGGLE_PUMP 0x03
+#define OP_WAIT_MS 0x04 // arg = delay before the next op
+#define OP_PUMP_RUN 0x05 // arg = run time in seconds, then off
+#define OP_ZONE_SET 0x06 // open exactly the target zones, close the rest (target 0 = all off)
+
+// --- BATCH FLAGS ---
+#define BATCH_FLAG_ATOMIC 0x01 // validate all ops first, run none if one is invalid
+
+// --- BENCH FLAGS ---
+#define BENCH_FLAG_ENCRYPTED 0x01    // ping was sent encrypted
+#define BENCH_FLAG_SWITCH_PLAIN 0x02 // hub: reply unencrypted until the bench goes idle
+#define BENCH_FLAG_GPIO 0x04         // hub: toggle the bench probe pin before replying
+#define BENCH_FLAG_END_PLAIN 0x08    // hub: plain pass over, encrypt again after replying
+
+// Every frame starts with this header.
+// session is picked at random when the remote boots, seq counts up from 1
+// inside a session. Together they let the hub spot retransmitted frames.
+typedef struct __attribute__((packed)) msg_header_t
+{
+    uint8_t type;
+    uint8_t version;
+    uint16_t reserved;
+    uint32_t session;
+    uint32_t seq;
+} msg_header_t;
+
+// Message Structure
+typedef struct __attribute__((packed)) struct_message
+{
+    msg_header_t hdr;
+    char command[32];
+} struct_message;
+
+// Hub -> Remote reply to a struct_message.
+// hdr.session/hdr.seq echo the command being acknowledged.
+typedef struct __attribute__((packed)) ack_message
+{
+    msg_header_t hdr;
+    uint8_t status;
+    uint8_t relayOn; // open zone mask
+    uint16_t reserved;
+    uint32_t hubTimeMs; // hub millis() when the command was executed
+} ack_message;
+
+// Remote -> Hub benchmark ping. The hub echoes it back with hdr.type set
+// to MSG_BENCH_PONG. Padded to the size of a struct_message so the
+// numbers match a real command frame.
+typedef struct __attribute__((packed)) bench_message
+{
+    msg_header_t hdr;
+    uint32_t sentMicros; // remote micros() at send time
+    uint8_t flags;
+    uint32_t hubUs; // pong with BENCH_FLAG_GPIO: hub receive to probe pin write
+    uint8_t padding[sizeof(struct_message) - sizeof(msg_header_t) - 9];
+} bench_message;
+
+// One step of a batch
+typedef struct __attribute__((packed)) batch_op_t
+{
+    uint8_t opcode;
+    uint8_t target;
+    uint16_t arg;
+} batch_op_t;
+
+#define BATCH_MAX_OPS ((ESPNOW_MAX_PAYLOAD - sizeof(msg_header_t) - 2) / sizeof(batch_op_t))
+#define BATCH_MESSAGE_LEN(n) (sizeof(msg_header_t) + 2 + (n) * sizeof(batch_op_t))
+
+// Remote -> Hub: several commands in one frame, run in order.
+// Only the first `count` ops are sent, see BATCH_MESSAGE_LEN.
+typedef struct __attribute__((packed)) batch_message
+{
+    msg_header_t hdr;
+    uint8_t count;
+    uint8_t flags;
+    batch_op_t ops[BATCH_MAX_OPS];
+} batch_message;
+
+#define BATCH_ACK_LEN(n) (sizeof(msg_header_t) + 6 + (n))
+
+// Hub -> Remote: one reply for the whole batch, sent when it has finished.
+// status[i] is the ACK_* result of ops[i].
+typedef struct __attribute__((packed)) batch_ack_message
+{
+    msg_header_t hdr;
+    uint8_t count;
+    uint8_t relayOn; // open zone mask
+    uint32_t hubTimeMs;
+    uint8_t status[BATCH_MAX_OPS];
+} batch_ack_message;
+
+// --- SAMPLE FLAGS ---
+#define SAMPLE_FLAG_NO_BME 0x01   // temperature/humidity/pressure invalid
+#define SAMPLE_FLAG_NO_LIGHT 0x02 // lux invalid
+
+// One hub sensor sample, fixed point so it packs into a few bytes.
+// The hub builds the screen's UART line and the ESP-NOW telemetry frame
+// from the same struct.
+typedef struct __attribute__((packed)) sensor_sample_t
+{
+    int16_t tempCenti;      // 0.01 degC
+    uint16_t humidityCenti; // 0.01 %RH
+    uint32_t pressurePa;
+    uint16_t lux;
+    uint8_t rain; // PIN_RAIN_DIGITAL level (LOW = wet)
+    uint8_t fert; // PIN_FERT_LEVEL level
+    uint8_t relayOn; // open zone mask
+    uint8_t flags;
+    uint16_t relayDutyPermille; // time any zone was open over the last hour, 0..1000
+    uint32_t hubTimeMs;
+} sensor_sample_t;
+
+// Hub -> broadcast. hdr.session is random per hub boot, hdr.seq counts
+// broadcasts so listeners can spot gaps.
+typedef struct __attribute__((packed)) telemetry_message
+{
+    msg_header_t hdr;
+    sensor_sample_t sample;
+} telemetry_message;
+
+// Pairing, all three messages share this layout.
+// BEACON: hdr.session is random per pairing window, channel is the hub's.
+// REQUEST: hdr is stamped like a command. ACCEPT: hdr echoes the request,
+// role is the ROLE_* the hub granted.
+typedef struct __attribute__((packed)) pair_message
+{
+    msg_header_t hdr;
+    uint8_t channel;
+    uint8_t role;
+    uint16_t reserved;
+} pair_message;
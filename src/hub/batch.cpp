@@ -0,0 +1,92 @@
+// File: src/hub/batch.cpp
+#include "batch.h"
+#include "hub.h"
+
+typedef struct batch_job_t
+{
+    bool active;
+    uint8_t mac[6];
+    msg_header_t hdr;
+    uint8_t count;
+    uint8_t next;
+    uint32_t dueMs;
+    batch_op_t ops[BATCH_MAX_OPS];
+    uint8_t status[BATCH_MAX_OPS];
+} batch_job_t;
+
+static batch_job_t job;
+
+void batchReject(const uint8_t *mac, const batch_message *batch, uint8_t status)
+{
+    uint8_t statuses[BATCH_MAX_OPS];
+    memset(statuses, status, batch->count);
+    sendBatchAck(mac, &batch->hdr, statuses, batch->count);
+}
+
+void batchStart(const uint8_t *mac, const batch_message *batch)
+{
+    if (job.active)
+    {
+        batchReject(mac, batch, ACK_BUSY);
+        return;
+    }
+
+    // Atomic batches are checked up front: one bad op and nothing runs
+    if (batch->flags & BATCH_FLAG_ATOMIC)
+    {
+        uint8_t statuses[BATCH_MAX_OPS];
+        bool ok = true;
+        for (uint8_t i = 0; i < batch->count; i++)
+        {
+            statuses[i] = opIsValid(&batch->ops[i]) ? ACK_SKIPPED : ACK_UNKNOWN;
+            ok = ok && statuses[i] == ACK_SKIPPED;
+        }
+        if (!ok)
+        {
+            Serial.println("Batch rejected: invalid op in atomic batch");
+            sendBatchAck(mac, &batch->hdr, statuses, batch->count);
+            return;
+        }
+    }
+
+    memcpy(job.mac, mac, 6);
+    job.hdr = batch->hdr;
+    job.count = batch->count;
+    job.next = 0;
+    job.dueMs = millis();
+    memcpy(job.ops, batch->ops, batch->count * sizeof(batch_op_t));
+    memset(job.status, ACK_SKIPPED, sizeof(job.status));
+    job.active = true;
+
+    batchPoll();
+}
+
+uint32_t batchPoll()
+{
+    if (!job.active)
+        return BATCH_IDLE;
+
+    while (job.next < job.count)
+    {
+        int32_t wait = (int32_t)(job.dueMs - millis());
+        if (wait > 0)
+            return (uint32_t)wait;
+
+        const batch_op_t *op = &job.ops[job.next];
+        if (op->opcode == OP_WAIT_MS)
+        {
+            // Count from when the wait was due, so delays do not accumulate jitter
+            job.dueMs += op->arg;
+            job.status[job.next] = ACK_OK;
+        }
+        else
+        {
+            job.status[job.next] = executeOp(op->opcode, op->target, op->arg);
+        }
+        job.next++;
+    }
+
+    sendBatchAck(job.mac, &job.hdr, job.status, job.count);
+    job.active = false;
+    return BATCH_IDLE;
+}
@@ -0,0 +1,20 @@
+// File: src/hub/batch.h
+// Runs a batch_message one op at a time from the command task.
+// OP_WAIT_MS steps are not slept through: batchPoll() tells the task how
+// long it may block on its queue before the next step is due.
+#pragma once
+
+#include <Arduino.h>
+#include "protocol.h"
+
+#define BATCH_IDLE UINT32_MAX
+
+// Takes ownership of a validated, authorised batch. Answers ACK_BUSY if
+// another batch is still running.
+void batchStart(const uint8_t *mac, const batch_message *batch);
+
+// Answers a batch that will not run with the same status for every op
+void batchReject(const uint8_t *mac, const batch_message *batch, uint8_t status);
+
+// Runs every op that is due. Returns ms until the next one, or BATCH_IDLE.
+uint32_t batchPoll();
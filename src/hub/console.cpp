@@ -0,0 +1,283 @@
+// File: src/hub/console.cpp
+#include <Arduino.h>
+#include <esp_now.h>
+#include <Preferences.h>
+#include "console.h"
+#include "hub.h"
+#include "peer_table.h"
+#include "mac_util.h"
+#include "key_util.h"
+#include "line_reader.h"
+#include "telemetry.h"
+#include "relay.h"
+#include "rules.h"
+#include "link_monitor.h"
+#include "pairing.h"
+
+#define CONSOLE_LINE_MAX 96
+
+#define CONSOLE_HISTORY 8
+
+static line_reader_t<CONSOLE_LINE_MAX, CONSOLE_HISTORY> line;
+
+static void printHelp()
+{
+    Serial.println("Commands:");
+    Serial.println("  peers                          list authorised remotes");
+    Serial.println("  peer add <mac> [control|ro]    authorise a remote");
+    Serial.println("  peer del <mac>                 remove a remote");
+    Serial.println("  peer key <mac> <32 hex>|none   set or clear a remote's LMK");
+    Serial.println("  pair [<s>] [control|ro]        open a pairing window (default 60 s)");
+    Serial.println("  pair off|status|scan           close, show, or rescan the channel");
+    Serial.println("  key pmk <32 hex>               set the primary master key");
+    Serial.println("  telemetry [<ms>|off]           show or set the broadcast interval");
+    Serial.println("  relay                          zone states and duty cycle");
+    Serial.println("  zones <mask>                   open exactly these zones (0 = all off)");
+    Serial.println("  rules [on|off|clear|default]   show or manage watering rules");
+    Serial.println("  rules cond <input> <op> <val>  add a condition, e.g. rules cond hum < 40");
+    Serial.println("  rules add <action> <c+c> <zones> [sec] [cooldown min]");
+    Serial.println("  clock [HH:MM|off]              set the time of day for rules");
+    Serial.println("  link                           per-remote radio statistics");
+    Serial.println("  jobs                           scheduler timings");
+    Serial.println("  stats                          command queue statistics");
+}
+
+static void cmdPeer(char *args)
+{
+    char *save = NULL;
+    char *verb = strtok_r(args, " ", &save);
+    char *macText = strtok_r(NULL, " ", &save);
+    char *roleText = strtok_r(NULL, " ", &save);
+    uint8_t mac[6];
+
+    if (verb == NULL || !parseMac(macText, mac))
+    {
+        Serial.println("Usage: peer add|del|key <AA:BB:CC:DD:EE:FF> [control|ro|<key>]");
+        return;
+    }
+
+    if (strcasecmp(verb, "add") == 0)
+    {
+        uint8_t role = ROLE_CONTROL;
+        if (roleText != NULL && (strcasecmp(roleText, "ro") == 0 || strcasecmp(roleText, "read-only") == 0))
+            role = ROLE_READ_ONLY;
+        else if (roleText != NULL && strcasecmp(roleText, "control") != 0)
+        {
+            Serial.printf("Unknown role '%s'\n", roleText);
+            return;
+        }
+
+        if (peerTableAdd(mac, role))
+        {
+            ensureEspNowPeer(mac);
+            Serial.printf("Peer " MAC_FMT " saved as %s\n", MAC_ARGS(mac), peerRoleName(role));
+        }
+        else
+        {
+            Serial.println("Error: peer table full");
+        }
+    }
+    else if (strcasecmp(verb, "del") == 0)
+    {
+        if (peerTableRemove(mac))
+        {
+            esp_now_del_peer(mac);
+            Serial.printf("Peer " MAC_FMT " removed\n", MAC_ARGS(mac));
+        }
+        else
+        {
+            Serial.println("Error: no such peer");
+        }
+    }
+    else if (strcasecmp(verb, "key") == 0)
+    {
+        uint8_t lmk[KEY_LEN];
+        bool clear = roleText != NULL && strcasecmp(roleText, "none") == 0;
+        if (!clear && !parseKey(roleText, lmk))
+        {
+            Serial.println("Usage: peer key <mac> <32 hex digits>|none");
+            return;
+        }
+        if (!peerTableSetKey(mac, clear ? NULL : lmk))
+        {
+            Serial.println("Error: no such peer");
+            return;
+        }
+        if (!setEspNowPeerEncryption(mac, !clear))
+            Serial.println("Warning: ESP-NOW rejected the peer (too many encrypted peers?)");
+        Serial.printf("Peer " MAC_FMT " is now %s\n", MAC_ARGS(mac), clear ? "plain" : "encrypted");
+    }
+    else
+    {
+        Serial.printf("Unknown peer command '%s'\n", verb);
+    }
+}
+
+static void cmdKey(char *args)
+{
+    char *save = NULL;
+    char *which = strtok_r(args, " ", &save);
+    char *keyText = strtok_r(NULL, " ", &save);
+    uint8_t pmk[KEY_LEN];
+
+    if (which == NULL || strcasecmp(which, "pmk") != 0 || !parseKey(keyText, pmk))
+    {
+        Serial.println("Usage: key pmk <32 hex digits>");
+        return;
+    }
+
+    Preferences prefs;
+    prefs.begin("hub", false);
+    prefs.putBytes("pmk", pmk, sizeof(pmk));
+    prefs.end();
+    esp_now_set_pmk(pmk);
+    Serial.println("PMK saved. Reboot to re-key existing encrypted peers.");
+}
+
+static void cmdTelemetry(char *args)
+{
+    while (*args == ' ')
+        args++;
+
+    if (strcasecmp(args, "off") == 0)
+        telemetrySetInterval(0);
+    else if (*args != '\0')
+        telemetrySetInterval(strtoul(args, NULL, 10));
+    telemetryPrintStats(Serial);
+}
+
+static void cmdZones(char *args)
+{
+    char *end = NULL;
+    unsigned long mask = strtoul(args, &end, 0);
+    if (end == args || mask > 0xFF)
+    {
+        Serial.println("Usage: zones <mask>, e.g. zones 0x03");
+        return;
+    }
+    relaySet((uint8_t)mask);
+}
+
+static void cmdPair(char *args)
+{
+    char *save = NULL;
+    char *first = strtok_r(args, " ", &save);
+    char *second = strtok_r(NULL, " ", &save);
+
+    if (first != NULL && strcasecmp(first, "off") == 0)
+        pairingClose();
+    else if (first != NULL && strcasecmp(first, "status") == 0)
+        pairingPrint(Serial);
+    else if (first != NULL && strcasecmp(first, "scan") == 0)
+    {
+        if (pairingStartScan())
+            Serial.println("Scanning, the channel is switched when it is done");
+        else if (pairingScanning())
+            Serial.println("Scan already running");
+    }
+    else
+    {
+        uint32_t seconds = PAIR_DEFAULT_WINDOW_S;
+        char *roleText = second;
+        if (first != NULL && isdigit((unsigned char)first[0]))
+            seconds = strtoul(first, NULL, 10);
+        else
+            roleText = first;
+
+        uint8_t role = ROLE_CONTROL;
+        if (roleText != NULL && (strcasecmp(roleText, "ro") == 0 || strcasecmp(roleText, "read-only") == 0))
+            role = ROLE_READ_ONLY;
+        else if (roleText != NULL && strcasecmp(roleText, "control") != 0)
+        {
+            Serial.println("Usage: pair [<seconds>] [control|ro], pair off|status|scan");
+            return;
+        }
+        if (seconds == 0 || seconds > 600)
+        {
+            Serial.println("Pairing window must be 1..600 s");
+            return;
+        }
+        pairingOpen(seconds, role);
+    }
+}
+
+static void cmdClock(char *args)
+{
+    unsigned h, m;
+    while (*args == ' ')
+        args++;
+
+    if (strcasecmp(args, "off") == 0)
+        rulesSetClock(-1);
+    else if (sscanf(args, "%u:%u", &h, &m) == 2 && h < 24 && m < 60)
+        rulesSetClock(h * 60 + m);
+    else if (*args != '\0')
+    {
+        Serial.println("Usage: clock [HH:MM|off]");
+        return;
+    }
+
+    int minute = rulesClock();
+    if (minute < 0)
+        Serial.println("Clock not set");
+    else
+        Serial.printf("Clock %02d:%02d\n", minute / 60, minute % 60);
+}
+
+static void execute(char *cmd)
+{
+    char *args = strchr(cmd, ' ');
+    if (args != NULL)
+        *args++ = '\0';
+    else
+        args = cmd + strlen(cmd);
+
+    if (strcasecmp(cmd, "help") == 0)
+        printHelp();
+    else if (strcasecmp(cmd, "peers") == 0)
+        peerTablePrint(Serial);
+    else if (strcasecmp(cmd, "peer") == 0)
+        cmdPeer(args);
+    else if (strcasecmp(cmd, "pair") == 0)
+        cmdPair(args);
+    else if (strcasecmp(cmd, "key") == 0)
+        cmdKey(args);
+    else if (strcasecmp(cmd, "telemetry") == 0)
+        cmdTelemetry(args);
+    else if (strcasecmp(cmd, "relay") == 0)
+        relayPrintStats(Serial);
+    else if (strcasecmp(cmd, "zones") == 0)
+        cmdZones(args);
+    else if (strcasecmp(cmd, "rules") == 0)
+        rulesCommand(args);
+    else if (strcasecmp(cmd, "clock") == 0)
+        cmdClock(args);
+    else if (strcasecmp(cmd, "link") == 0)
+        linkMonitorPrint(Serial);
+    else if (strcasecmp(cmd, "jobs") == 0)
+        printJobStats();
+    else if (strcasecmp(cmd, "stats") == 0)
+    {
+        printQueueStats();
+        telemetryPrintStats(Serial);
+    }
+    else
+        Serial.printf("Unknown command '%s', type 'help'\n", cmd);
+}
+
+void consoleBegin()
+{
+    lineReaderInit(&line, true);
+}
+
+void consolePoll()
+{
+    // One command per call, the rest waits for the next scheduler pass
+    const char *text = lineReaderPoll(&line, Serial, &Serial);
+    if (text != NULL)
+    {
+        char cmd[CONSOLE_LINE_MAX];
+        strcpy(cmd, text);
+        execute(cmd);
+    }
+}
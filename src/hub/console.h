@@ -0,0 +1,6 @@
+// File: src/hub/console.h
+// Serial console for provisioning and diagnostics. Type "help" for commands.
+#pragma once
+
+void consoleBegin();
+void consolePoll();
@@ -0,0 +1,65 @@
+// File: src/hub/dedup_window.h
+// Sliding duplicate-suppression window, one per remote.
+// Remembers the highest sequence number seen and a bitmap of the 32
+// numbers below it, so the check is a couple of shifts and no allocation.
+#pragma once
+
+#include <stdint.h>
+
+#define DEDUP_WINDOW_SIZE 32
+
+typedef struct dedup_window_t
+{
+    bool valid;
+    uint32_t session;
+    uint32_t highest;
+    uint32_t seen; // bit N set = (highest - N) already accepted
+} dedup_window_t;
+
+enum dedup_result_t
+{
+    DEDUP_NEW,       // first copy, execute it
+    DEDUP_DUPLICATE, // already executed, acknowledge only
+    DEDUP_TOO_OLD    // fell out of the window, treat as duplicate
+};
+
+inline void dedupReset(dedup_window_t *w)
+{
+    w->valid = false;
+    w->session = 0;
+    w->highest = 0;
+    w->seen = 0;
+}
+
+inline dedup_result_t dedupCheck(dedup_window_t *w, uint32_t session, uint32_t seq)
+{
+    // New session (remote rebooted): start a fresh window
+    if (!w->valid || session != w->session)
+    {
+        w->valid = true;
+        w->session = session;
+        w->highest = seq;
+        w->seen = 1;
+        return DEDUP_NEW;
+    }
+
+    if (seq > w->highest)
+    {
+        uint32_t shift = seq - w->highest;
+        w->seen = (shift >= DEDUP_WINDOW_SIZE) ? 1 : (w->seen << shift) | 1;
+        w->highest = seq;
+        return DEDUP_NEW;
+    }
+
+    uint32_t offset = w->highest - seq;
+    if (offset >= DEDUP_WINDOW_SIZE)
+        return DEDUP_TOO_OLD;
+
+    uint32_t bit = 1UL << offset;
+    if (w->seen & bit)
+        return DEDUP_DUPLICATE;
+
+    // Arrived out of order but never executed
+    w->seen |= bit;
+    return DEDUP_NEW;
+}
@@ -0,0 +1,16 @@
+// File: src/hub/hub.h
+// Functions main_hub.cpp shares with the other hub modules.
+#pragma once
+
+#include <Arduino.h>
+#include "protocol.h"
+
+void printQueueStats();
+void printJobStats();
+bool ensureEspNowPeer(const uint8_t *mac);
+bool setEspNowPeerEncryption(const uint8_t *mac, bool encrypt);
+
+// Command execution, only called from the command task
+uint8_t executeOp(uint8_t opcode, uint8_t target, uint16_t arg);
+bool opIsValid(const batch_op_t *op);
+void sendBatchAck(const uint8_t *mac, const msg_header_t *hdr, const uint8_t *status, uint8_t count);
@@ -0,0 +1,93 @@
+// File: src/hub/link_monitor.cpp
+#include "link_monitor.h"
+#include "link_stats.h"
+#include <esp_now.h>
+#include "pairing.h"
+
+static link_stats_t links[LINK_MAX];
+static link_stats_t *latest = NULL;
+
+// The WiFi task (RSSI, send results) and the command task both update
+static portMUX_TYPE linkLock = portMUX_INITIALIZER_UNLOCKED;
+
+static void onPromiscuous(void *buf, wifi_promiscuous_pkt_type_t type)
+{
+    const uint8_t *mac;
+    int8_t rssi;
+    if (!linkParseEspNow(buf, type, &mac, &rssi) || !peerTableContains(mac))
+        return;
+
+    portENTER_CRITICAL(&linkLock);
+    linkOnRssi(linkFind(links, LINK_MAX, mac, true), rssi);
+    portEXIT_CRITICAL(&linkLock);
+}
+
+static void onDataSent(const uint8_t *mac, esp_now_send_status_t status)
+{
+    // Broadcasts are never acknowledged, so their result says nothing
+    static const uint8_t broadcast[6] = {0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF};
+    if (mac == NULL || memcmp(mac, broadcast, 6) == 0)
+        return;
+    pairingOnSent(mac);
+
+    portENTER_CRITICAL(&linkLock);
+    link_stats_t *l = linkFind(links, LINK_MAX, mac, false);
+    if (l != NULL)
+        linkOnSent(l, status == ESP_NOW_SEND_SUCCESS);
+    portEXIT_CRITICAL(&linkLock);
+}
+
+void linkMonitorBegin()
+{
+    esp_now_register_send_cb(onDataSent);
+    linkEnableRssi(onPromiscuous);
+}
+
+void linkMonitorFrame(const uint8_t *mac, const msg_header_t *hdr, bool duplicate)
+{
+    if (!peerTableContains(mac))
+        return;
+
+    portENTER_CRITICAL(&linkLock);
+    link_stats_t *l = linkFind(links, LINK_MAX, mac, true);
+    if (hdr != NULL)
+        linkOnFrame(l, hdr->session, hdr->seq, duplicate);
+    else
+        linkOnRx(l);
+    latest = l;
+    portEXIT_CRITICAL(&linkLock);
+}
+
+bool linkMonitorLatest(int8_t *rssi, uint16_t *lossPermille)
+{
+    bool found = false;
+    portENTER_CRITICAL(&linkLock);
+    if (latest != NULL && latest->used)
+    {
+        *rssi = linkRssiAvg(latest);
+        *lossPermille = linkLossPermille(latest);
+        found = true;
+    }
+    portEXIT_CRITICAL(&linkLock);
+    return found;
+}
+
+void linkMonitorPrint(Print &out)
+{
+    link_stats_t copy[LINK_MAX];
+    portENTER_CRITICAL(&linkLock);
+    memcpy(copy, links, sizeof(copy));
+    portEXIT_CRITICAL(&linkLock);
+
+    out.println("Links:");
+    bool any = false;
+    for (size_t i = 0; i < LINK_MAX; i++)
+    {
+        if (!copy[i].used)
+            continue;
+        linkPrint(out, &copy[i]);
+        any = true;
+    }
+    if (!any)
+        out.println("  nothing heard yet");
+}
@@ -0,0 +1,29 @@
+// File: src/hub/link_monitor.h
+// Per-remote ESP-NOW link quality on the hub: frame, gap and duplicate
+// counters from the command path, send results from OnDataSent and RSSI
+// from the promiscuous callback. Entries are keyed by MAC and only made
+// for peers in the peer table, so with LINK_MAX == PEER_MAX a slot is
+// only taken over (the one heard from longest ago) once a peer has been
+// removed and another paired in its place.
+#pragma once
+
+#include <Arduino.h>
+#include "protocol.h"
+#include "peer_table.h"
+
+#define LINK_MAX PEER_MAX
+
+// Turns on promiscuous RSSI sampling and the send callback. Call after
+// esp_now_init().
+void linkMonitorBegin();
+
+// From the command task, once the dedup result is known. hdr NULL counts
+// a frame outside the command sequence (bench pings). Frames from MACs
+// not in the peer table are ignored.
+void linkMonitorFrame(const uint8_t *mac, const msg_header_t *hdr, bool duplicate);
+
+// RSSI and loss of the remote heard from most recently, for the screen.
+// Returns false until any remote has been heard.
+bool linkMonitorLatest(int8_t *rssi, uint16_t *lossPermille);
+
+void linkMonitorPrint(Print &out);
@@ -5,74 +5,489 @@
 #include <BH1750.h>
 #include <esp_now.h>
 #include <WiFi.h>
+#include <Preferences.h>
+#include "soc/soc.h"
+#include "soc/gpio_reg.h"
+#include "protocol.h"
+#include "hub.h"
+#include "peer_table.h"
+#include "console.h"
+#include "batch.h"
+#include "telemetry.h"
+#include "relay.h"
+#include "rules.h"
+#include "link_monitor.h"
+#include "pairing.h"
+#include "scheduler.h"
 
 // --- PIN CONFIGURATION ---
 #define PIN_SDA 11
 #define PIN_SCL 12
 #define PIN_RAIN_DIGITAL 10
 #define PIN_FERT_LEVEL 14
+// Relay outputs are listed in the zone table, see zones.h
 
-// !!! MOVED TO GPIO 4 (Safer than GPIO 0) !!!
-#define PIN_PUMP_RELAY 4
+// Toggled by GPIO benchmark pings, wire it to the remote's sense pin
+#define PIN_BENCH_PROBE 6
 
 #define PIN_TX_TO_SCREEN 44
 #define PIN_RX_FROM_SCREEN 43
 
-// --- SECURITY: AUTHORIZED REMOTE ---
-const uint8_t remoteMac[] = {0x58, 0xBF, 0x25, 0x12, 0xD6, 0x88};
+// --- SECURITY: AUTHORIZED REMOTES ---
+// Remotes live in the peer table (NVS) and are added by pairing ("pair"
+// on the console) or by hand ("peer add ...").
+
+#define SAMPLE_INTERVAL_MS 1000
 
 Adafruit_BME280 bme;
 BH1750 lightMeter;
 HardwareSerial ScreenSerial(1);
 
-typedef struct struct_message
+// --- COMMAND QUEUE ---
+// OnDataRecv runs inside the WiFi task, so it only copies the frame into
+// a preallocated queue. commandTask does the GPIO work and the logging.
+#define CMD_QUEUE_DEPTH 16
+#define CMD_TASK_STACK 4096
+#define CMD_TASK_PRIORITY 2
+#define QUEUE_STATS_INTERVAL_MS 60000
+
+typedef struct rx_frame_t
 {
-    char command[32];
-} struct_message;
+    uint8_t mac[6];
+    uint8_t len;
+    uint32_t rxMicros;
+    uint8_t data[ESP_NOW_MAX_DATA_LEN];
+} rx_frame_t;
+
+static StaticQueue_t cmdQueueBuffer;
+static uint8_t cmdQueueStorage[CMD_QUEUE_DEPTH * sizeof(rx_frame_t)];
+static QueueHandle_t cmdQueue = NULL;
+
+// Only the WiFi task writes these, everyone else just reads them
+static volatile uint32_t rxQueued = 0;
+static volatile uint32_t rxDropped = 0;
+static volatile UBaseType_t rxHighWater = 0;
+
+// Only touched by commandTask
+static uint32_t rxDuplicates = 0;
+static uint32_t rxDenied = 0;
 
 void OnDataRecv(const uint8_t *mac, const uint8_t *incomingData, int len)
 {
-    if (memcmp(mac, remoteMac, 6) != 0)
+    if (!peerTableContains(mac) && !pairingAccepts(incomingData, len))
+        return;
+    if (len <= 0 || len > ESP_NOW_MAX_DATA_LEN)
+        return;
+
+    rx_frame_t frame;
+    memcpy(frame.mac, mac, 6);
+    frame.len = (uint8_t)len;
+    frame.rxMicros = micros();
+    memcpy(frame.data, incomingData, len);
+
+    // Never block the radio: a full queue means the frame is dropped
+    if (xQueueSend(cmdQueue, &frame, 0) != pdTRUE)
+    {
+        rxDropped++;
         return;
+    }
+
+    rxQueued++;
+    UBaseType_t depth = uxQueueMessagesWaiting(cmdQueue);
+    if (depth > rxHighWater)
+        rxHighWater = depth;
+}
+
+uint8_t executeOp(uint8_t opcode, uint8_t target, uint16_t arg)
+{
+    uint8_t zones = target ? target : ZONE_DEFAULT_MASK;
+    switch (opcode)
+    {
+    case OP_TOGGLE_PUMP:
+        return relayToggle(zones);
+    case OP_PUMP_ON:
+        return relayStart(zones, 0);
+    case OP_PUMP_OFF:
+        return relayStop(zones);
+    case OP_PUMP_RUN:
+        if (arg == 0)
+            return ACK_UNKNOWN;
+        return relayStart(zones, (uint32_t)arg * 1000UL);
+    case OP_ZONE_SET:
+        return relaySet(target);
+    default:
+        return ACK_UNKNOWN;
+    }
+}
 
-    struct_message *msg = (struct_message *)incomingData;
+bool opIsValid(const batch_op_t *op)
+{
+    if (op->target & ~ZONE_ALL_MASK)
+        return false;
+    switch (op->opcode)
+    {
+    case OP_TOGGLE_PUMP:
+    case OP_PUMP_ON:
+    case OP_PUMP_OFF:
+    case OP_WAIT_MS:
+    case OP_ZONE_SET:
+        return true;
+    case OP_PUMP_RUN:
+        return op->arg != 0 && op->arg * 1000UL <= RELAY_MAX_RUNTIME_MS;
+    default:
+        return false;
+    }
+}
+
+uint8_t handleCommand(const struct_message *msg)
+{
     Serial.print("Command: ");
     Serial.println(msg->command);
 
-    // --- LOGIC FIXED FOR ACTIVE LOW RELAY ---
-    // ON  = LOW
-    // OFF = HIGH
-
     if (strcmp(msg->command, "TOGGLE_PUMP") == 0)
+        return executeOp(OP_TOGGLE_PUMP, 0, 0);
+    else if (strcmp(msg->command, "PUMP_ON") == 0)
+        return executeOp(OP_PUMP_ON, 0, 0);
+    else if (strcmp(msg->command, "PUMP_OFF") == 0)
+        return executeOp(OP_PUMP_OFF, 0, 0);
+    else if (strncmp(msg->command, "PUMP_RUN:", 9) == 0)
     {
-        int state = digitalRead(PIN_PUMP_RELAY);
-        digitalWrite(PIN_PUMP_RELAY, !state); // Flip state
-        // Log the human-readable status
-        Serial.println(!state == LOW ? "Action: Pump ON" : "Action: Pump OFF");
+        // "PUMP_RUN:<seconds>"
+        unsigned long seconds = strtoul(msg->command + 9, NULL, 10);
+        if (seconds == 0 || seconds > UINT16_MAX)
+            return ACK_UNKNOWN;
+        return executeOp(OP_PUMP_RUN, 0, (uint16_t)seconds);
     }
-    else if (strcmp(msg->command, "PUMP_ON") == 0)
+    else if (strncmp(msg->command, "ZONES:", 6) == 0)
     {
-        digitalWrite(PIN_PUMP_RELAY, LOW); // LOW IS ON
-        Serial.println("Action: Pump ON");
+        // "ZONES:<mask>", decimal or 0x hex
+        char *end = NULL;
+        unsigned long mask = strtoul(msg->command + 6, &end, 0);
+        if (end == msg->command + 6 || mask > 0xFF)
+            return ACK_UNKNOWN;
+        return executeOp(OP_ZONE_SET, (uint8_t)mask, 0);
     }
-    else if (strcmp(msg->command, "PUMP_OFF") == 0)
+    return ACK_UNKNOWN;
+}
+
+// Builds the ESP-NOW peer entry from the peer table (LMK if provisioned)
+static bool fillPeerInfo(const uint8_t *mac, bool encrypt, esp_now_peer_info_t *peerInfo)
+{
+    peer_record_t rec;
+    if (!peerTableLookup(mac, &rec))
+        return false;
+
+    memset(peerInfo, 0, sizeof(*peerInfo));
+    memcpy(peerInfo->peer_addr, mac, 6);
+    peerInfo->channel = 0;
+    peerInfo->encrypt = encrypt && (rec.flags & PEER_FLAG_ENCRYPT);
+    if (peerInfo->encrypt)
+        memcpy(peerInfo->lmk, rec.lmk, ESP_NOW_KEY_LEN);
+    return true;
+}
+
+bool ensureEspNowPeer(const uint8_t *mac)
+{
+    if (esp_now_is_peer_exist(mac))
+        return true;
+
+    esp_now_peer_info_t peerInfo;
+    if (!fillPeerInfo(mac, true, &peerInfo))
+        return false;
+
+    esp_err_t err = esp_now_add_peer(&peerInfo);
+    if (err == ESP_ERR_ESPNOW_FULL)
+    {
+        // More remotes than ESP-NOW peer slots: recycle one
+        esp_now_peer_info_t victim;
+        if (esp_now_fetch_peer(true, &victim) == ESP_OK)
+            esp_now_del_peer(victim.peer_addr);
+        err = esp_now_add_peer(&peerInfo);
+    }
+    return err == ESP_OK;
+}
+
+bool setEspNowPeerEncryption(const uint8_t *mac, bool encrypt)
+{
+    esp_now_peer_info_t peerInfo;
+    if (!fillPeerInfo(mac, encrypt, &peerInfo))
+        return false;
+    if (!esp_now_is_peer_exist(mac))
+        return ensureEspNowPeer(mac);
+    return esp_now_mod_peer(&peerInfo) == ESP_OK;
+}
+
+// --- BENCHMARK ECHO ---
+// Pings take the same queue and task as commands so the remote measures
+// the real command path. A control remote may ask for plain replies
+// while it benchmarks without encryption; it ends that with an
+// END_PLAIN ping, and until then commands from it are refused, since
+// anyone can send plain frames with its address. Should the remote
+// never send it, the peer reverts once the pings have stopped for
+// BENCH_IDLE_RESTORE_MS.
+// GPIO pings flip the probe pin with the same single register write the
+// relay bank uses, so the remote can time command-to-pin without
+// switching a zone (and without the zones' minimum off-time). They carry
+// command sequence numbers, so a retransmit does not flip the pin again.
+#define BENCH_IDLE_RESTORE_MS 2000
+
+static uint8_t benchPlainMac[6];
+static bool benchPlainActive = false;
+static uint32_t benchLastPingMs = 0;
+static bool benchProbeHigh = false;
+
+static bool benchPlainFrom(const uint8_t *mac)
+{
+    return benchPlainActive && memcmp(benchPlainMac, mac, 6) == 0;
+}
+
+void handleBenchPing(const rx_frame_t *frame)
+{
+    if (frame->len != sizeof(bench_message))
+        return;
+
+    bench_message ping;
+    memcpy(&ping, frame->data, sizeof(ping));
+
+    // Switching and the probe pin are for control peers only; the pin
+    // also only moves for the first copy of a ping
+    uint8_t wants = ping.flags & (BENCH_FLAG_SWITCH_PLAIN | BENCH_FLAG_GPIO | BENCH_FLAG_END_PLAIN);
+    bool allowed = false;
+    bool endPlain = false;
+    if (wants)
     {
-        digitalWrite(PIN_PUMP_RELAY, HIGH); // HIGH IS OFF
-        Serial.println("Action: Pump OFF");
+        peer_admit_t admit;
+        if (!peerTableCheck(frame->mac, ping.hdr.session, ping.hdr.seq, &admit))
+            return;
+        // Ending plain mode only makes the hub stricter, so a repeat or a
+        // spoofed copy may do it too
+        endPlain = (ping.flags & BENCH_FLAG_END_PLAIN) && benchPlainFrom(frame->mac);
+        linkMonitorFrame(frame->mac, &ping.hdr, admit.dedup == DEDUP_DUPLICATE);
+        allowed = admit.role == ROLE_CONTROL && admit.dedup == DEDUP_NEW;
+        if (admit.role != ROLE_CONTROL)
+            rxDenied++;
+        else if (admit.dedup != DEDUP_NEW)
+            rxDuplicates++;
+    }
+    else
+    {
+        linkMonitorFrame(frame->mac, NULL, false);
+    }
+
+    bool switchPlain = allowed && (ping.flags & BENCH_FLAG_SWITCH_PLAIN);
+    if (switchPlain)
+    {
+        if (benchPlainActive && memcmp(benchPlainMac, frame->mac, 6) != 0)
+            setEspNowPeerEncryption(benchPlainMac, true);
+        memcpy(benchPlainMac, frame->mac, 6);
+        benchPlainActive = true;
+    }
+    if (benchPlainFrom(frame->mac))
+        benchLastPingMs = millis();
+
+    if (allowed && (ping.flags & BENCH_FLAG_GPIO))
+    {
+        benchProbeHigh = !benchProbeHigh;
+        REG_WRITE(benchProbeHigh ? GPIO_OUT_W1TS_REG : GPIO_OUT_W1TC_REG, 1UL << PIN_BENCH_PROBE);
+        ping.hubUs = micros() - frame->rxMicros;
+    }
+
+    ping.hdr.type = MSG_BENCH_PONG;
+    if (!ensureEspNowPeer(frame->mac) || esp_now_send(frame->mac, (uint8_t *)&ping, sizeof(ping)) != ESP_OK)
+        Serial.println("Error sending bench pong");
+
+    // Switch after the reply so the switch request itself is answered
+    // encrypted, and the end request in plain as the remote expects
+    if (switchPlain)
+        setEspNowPeerEncryption(frame->mac, false);
+    if (endPlain)
+    {
+        setEspNowPeerEncryption(frame->mac, true);
+        benchPlainActive = false;
     }
 }
 
+void benchRestoreIfIdle()
+{
+    if (benchPlainActive && millis() - benchLastPingMs >= BENCH_IDLE_RESTORE_MS)
+    {
+        setEspNowPeerEncryption(benchPlainMac, true);
+        benchPlainActive = false;
+    }
+}
+
+void sendBatchAck(const uint8_t *mac, const msg_header_t *hdr, const uint8_t *status, uint8_t count)
+{
+    batch_ack_message ack;
+    memset(&ack, 0, sizeof(ack));
+    ack.hdr.type = MSG_BATCH_ACK;
+    ack.hdr.version = PROTOCOL_VERSION;
+    ack.hdr.session = hdr->session;
+    ack.hdr.seq = hdr->seq;
+    ack.count = count;
+    ack.relayOn = relayOpenMask();
+    ack.hubTimeMs = millis();
+    memcpy(ack.status, status, count);
+
+    if (!ensureEspNowPeer(mac) || esp_now_send(mac, (uint8_t *)&ack, BATCH_ACK_LEN(count)) != ESP_OK)
+        Serial.println("Error sending batch ACK");
+}
+
+void sendAck(const uint8_t *mac, const msg_header_t *hdr, uint8_t status)
+{
+    ack_message ack;
+    memset(&ack, 0, sizeof(ack));
+    ack.hdr.type = MSG_ACK;
+    ack.hdr.version = PROTOCOL_VERSION;
+    ack.hdr.session = hdr->session;
+    ack.hdr.seq = hdr->seq;
+    ack.status = status;
+    ack.relayOn = relayOpenMask();
+    ack.hubTimeMs = millis();
+
+    if (!ensureEspNowPeer(mac) || esp_now_send(mac, (uint8_t *)&ack, sizeof(ack)) != ESP_OK)
+        Serial.println("Error sending ACK");
+}
+
+void handleBatchFrame(const rx_frame_t *frame)
+{
+    batch_message batch;
+    memset(&batch, 0, sizeof(batch));
+    memcpy(&batch, frame->data, min((size_t)frame->len, sizeof(batch)));
+    if (batch.hdr.version != PROTOCOL_VERSION || batch.count == 0 || batch.count > BATCH_MAX_OPS ||
+        frame->len < BATCH_MESSAGE_LEN(batch.count))
+        return;
+
+    peer_admit_t admit;
+    if (!peerTableCheck(frame->mac, batch.hdr.session, batch.hdr.seq, &admit))
+        return;
+    linkMonitorFrame(frame->mac, &batch.hdr, admit.dedup == DEDUP_DUPLICATE);
+
+    Serial.printf("Batch: seq %u, %u ops\n", (unsigned)batch.hdr.seq, batch.count);
+    if (admit.dedup != DEDUP_NEW)
+    {
+        rxDuplicates++;
+        batchReject(frame->mac, &batch, ACK_DUPLICATE);
+    }
+    else if (admit.role != ROLE_CONTROL || benchPlainFrom(frame->mac))
+    {
+        rxDenied++;
+        batchReject(frame->mac, &batch, ACK_DENIED);
+    }
+    else
+    {
+        batchStart(frame->mac, &batch);
+    }
+}
+
+void commandTask(void *param)
+{
+    rx_frame_t frame;
+    uint32_t reportedDrops = 0;
+
+    for (;;)
+    {
+        // Sleep until the next frame, the next batch step or the bench timeout
+        uint32_t batchWaitMs = batchPoll();
+        TickType_t wait = (batchWaitMs == BATCH_IDLE) ? portMAX_DELAY : pdMS_TO_TICKS(batchWaitMs);
+        if (benchPlainActive && wait > pdMS_TO_TICKS(100))
+            wait = pdMS_TO_TICKS(100);
+        BaseType_t got = xQueueReceive(cmdQueue, &frame, wait);
+        benchRestoreIfIdle();
+        if (got != pdTRUE)
+            continue;
+
+        uint32_t drops = rxDropped;
+        if (drops != reportedDrops)
+        {
+            Serial.printf("Warning: %u frames dropped (queue high-water %u/%u)\n",
+                          (unsigned)(drops - reportedDrops), (unsigned)rxHighWater, CMD_QUEUE_DEPTH);
+            reportedDrops = drops;
+        }
+
+        if (frame.len < sizeof(msg_header_t))
+            continue;
+
+        if (frame.data[0] == MSG_BENCH_PING)
+        {
+            handleBenchPing(&frame);
+            continue;
+        }
+
+        if (frame.data[0] == MSG_BATCH)
+        {
+            handleBatchFrame(&frame);
+            continue;
+        }
+
+        if (frame.data[0] == MSG_PAIR_REQUEST)
+        {
+            pairingHandleRequest(frame.mac, frame.data, frame.len);
+            continue;
+        }
+
+        // Short or unterminated frames are padded with zeros
+        struct_message msg;
+        memset(&msg, 0, sizeof(msg));
+        memcpy(&msg, frame.data, min((size_t)frame.len, sizeof(msg) - 1));
+        if (msg.hdr.type != MSG_COMMAND || msg.hdr.version != PROTOCOL_VERSION)
+            continue;
+
+        peer_admit_t admit;
+        if (!peerTableCheck(frame.mac, msg.hdr.session, msg.hdr.seq, &admit))
+            continue; // removed while the frame was queued
+        linkMonitorFrame(frame.mac, &msg.hdr, admit.dedup == DEDUP_DUPLICATE);
+
+        // Retransmits are acknowledged again but never re-executed
+        if (admit.dedup != DEDUP_NEW)
+        {
+            rxDuplicates++;
+            Serial.printf("Duplicate: seq %u ignored\n", (unsigned)msg.hdr.seq);
+            sendAck(frame.mac, &msg.hdr, ACK_DUPLICATE);
+            continue;
+        }
+
+        if (admit.role != ROLE_CONTROL)
+        {
+            rxDenied++;
+            Serial.printf("Denied: %s from read-only peer\n", msg.command);
+            sendAck(frame.mac, &msg.hdr, ACK_DENIED);
+            continue;
+        }
+
+        // Plain frames could come from anyone while a benchmark runs
+        if (benchPlainFrom(frame.mac))
+        {
+            rxDenied++;
+            Serial.printf("Denied: %s while benchmarking without encryption\n", msg.command);
+            sendAck(frame.mac, &msg.hdr, ACK_DENIED);
+            continue;
+        }
+
+        sendAck(frame.mac, &msg.hdr, handleCommand(&msg));
+    }
+}
+
+void printQueueStats()
+{
+    Serial.printf("Queue: %u frames, %u dropped, %u duplicates, %u denied, high-water %u/%u\n",
+                  (unsigned)rxQueued, (unsigned)rxDropped, (unsigned)rxDuplicates, (unsigned)rxDenied,
+                  (unsigned)rxHighWater, CMD_QUEUE_DEPTH);
+}
+
 void setup()
 {
     Serial.begin(115200);
+    consoleBegin();
     ScreenSerial.begin(115200, SERIAL_8N1, PIN_RX_FROM_SCREEN, PIN_TX_TO_SCREEN);
 
     pinMode(PIN_RAIN_DIGITAL, INPUT);
     pinMode(PIN_FERT_LEVEL, INPUT_PULLUP);
+    pinMode(PIN_BENCH_PROBE, OUTPUT);
+    digitalWrite(PIN_BENCH_PROBE, LOW);
 
-    pinMode(PIN_PUMP_RELAY, OUTPUT);
-    // START HIGH so the pump stays OFF when booting
-    digitalWrite(PIN_PUMP_RELAY, HIGH);
+    // Active LOW relays: start HIGH so no zone opens when booting
+    relayBegin();
 
     Wire.begin(PIN_SDA, PIN_SCL);
     if (!bme.begin(0x76))
@@ -80,30 +495,113 @@ void setup()
     if (!lightMeter.begin(BH1750::CONTINUOUS_HIGH_RES_MODE))
         Serial.println("Warning: BH1750 not found");
 
+    rulesBegin();
+    peerTableBegin(NULL);
+    cmdQueue = xQueueCreateStatic(CMD_QUEUE_DEPTH, sizeof(rx_frame_t), cmdQueueStorage, &cmdQueueBuffer);
+    xTaskCreatePinnedToCore(commandTask, "cmd", CMD_TASK_STACK, NULL, CMD_TASK_PRIORITY, NULL, tskNO_AFFINITY);
+
     WiFi.mode(WIFI_STA);
+    pairingBegin();
     if (esp_now_init() == ESP_OK)
     {
         esp_now_register_recv_cb(OnDataRecv);
-        Serial.println("Hub Ready.");
+        linkMonitorBegin();
+
+        // Primary master key, provisioned with "key pmk <hex>"
+        uint8_t pmk[ESP_NOW_KEY_LEN];
+        Preferences prefs;
+        if (prefs.begin("hub", true))
+        {
+            if (prefs.getBytes("pmk", pmk, sizeof(pmk)) == sizeof(pmk))
+                esp_now_set_pmk(pmk);
+            prefs.end();
+        }
+
+        // Remotes must be ESP-NOW peers so ACKs can be sent back to them
+        peer_record_t rec;
+        for (size_t i = 0; i < ESP_NOW_MAX_TOTAL_PEER_NUM && peerTableGet(i, &rec); i++)
+            ensureEspNowPeer(rec.mac);
+
+        telemetryBegin();
+        Serial.printf("Hub Ready. %u authorised remote(s).\n", (unsigned)peerTableCount());
     }
 }
 
-void loop()
+void readSample(sensor_sample_t *s)
 {
     float t = bme.readTemperature();
     float h = bme.readHumidity();
-    float p = bme.readPressure() / 100.0F;
+    float p = bme.readPressure();
     float l = lightMeter.readLightLevel();
-    int rain = digitalRead(PIN_RAIN_DIGITAL);
-    int fert = digitalRead(PIN_FERT_LEVEL);
 
-    String packet = "T=" + String(t, 1) +
-                    ";H=" + String(h, 0) +
-                    ";P=" + String(p, 0) +
-                    ";L=" + String(l, 0) +
-                    ";R=" + String(rain) +
-                    ";F=" + String(fert) + ";\n";
+    memset(s, 0, sizeof(*s));
+    if (isnan(t) || isnan(h) || isnan(p))
+    {
+        s->flags |= SAMPLE_FLAG_NO_BME;
+    }
+    else
+    {
+        s->tempCenti = (int16_t)lroundf(t * 100.0F);
+        s->humidityCenti = (uint16_t)lroundf(constrain(h, 0.0F, 100.0F) * 100.0F);
+        s->pressurePa = (uint32_t)lroundf(p);
+    }
+    if (l < 0)
+        s->flags |= SAMPLE_FLAG_NO_LIGHT;
+    else
+        s->lux = (uint16_t)constrain(lroundf(l), 0L, 65535L);
+
+    s->rain = digitalRead(PIN_RAIN_DIGITAL);
+    s->fert = digitalRead(PIN_FERT_LEVEL);
+    s->relayOn = relayOpenMask();
+    s->relayDutyPermille = relayDutyPermille();
+    s->hubTimeMs = millis();
+}
+
+void sendSensorPacket()
+{
+    sensor_sample_t s;
+    readSample(&s);
 
+    char packet[112];
+    int n = snprintf(packet, sizeof(packet), "T=%.1f;H=%.0f;P=%.0f;L=%u;R=%u;F=%u;",
+                     s.tempCenti / 100.0, s.humidityCenti / 100.0, s.pressurePa / 100.0,
+                     s.lux, s.rain, s.fert);
+
+    // Link to the remote heard last: S = RSSI in dBm, Q = loss in 0.1 %
+    int8_t rssi;
+    uint16_t loss;
+    if (linkMonitorLatest(&rssi, &loss))
+        n += snprintf(packet + n, sizeof(packet) - n, "S=%d;Q=%u;", rssi, loss);
+    snprintf(packet + n, sizeof(packet) - n, "\n");
     ScreenSerial.print(packet);
-    delay(1000);
-}
\ No newline at end of file
+
+    telemetryOffer(&s);
+    rulesOnSample(&s);
+}
+
+// --- SCHEDULER ---
+// Everything periodic on the loop() task. Remote commands switch zones
+// from the command task; here the rules (from sendSensorPacket) start
+// and stop zones too, and relayTick enforces timers and the watchdog.
+// The relay module locks its state, so both tasks may call it.
+static sched_job_t jobs[] = {
+    {"console", 20, consolePoll, 0, 0, 0},
+    {"relay", RELAY_TICK_MS, relayTick, 0, 0, 0},
+    {"telemetry", 50, telemetryPoll, 0, 0, 0},
+    {"pairing", 20, pairingPoll, 0, 0, 0},
+    {"sensors", SAMPLE_INTERVAL_MS, sendSensorPacket, 0, 0, 0},
+    {"stats", QUEUE_STATS_INTERVAL_MS, printQueueStats, 0, 0, 0},
+};
+
+void printJobStats()
+{
+    schedulerPrintStats(Serial, jobs, sizeof(jobs) / sizeof(jobs[0]));
+}
+
+void loop()
+{
+    uint32_t idleMs = schedulerRun(jobs, sizeof(jobs) / sizeof(jobs[0]));
+
+    // Sleep until the next job is due, never longer than a console tick
+    vTaskDelay(pdMS_TO_TICKS(constrain(idleMs, (uint32_t)1, (uint32_t)20)));
+}
@@ -0,0 +1,295 @@
+// File: src/hub/pairing.cpp
+#include "pairing.h"
+#include "hub.h"
+#include "peer_table.h"
+#include "mac_util.h"
+#include <WiFi.h>
+#include <esp_now.h>
+#include <esp_wifi.h>
+#include <Preferences.h>
+
+static const uint8_t broadcastMac[6] = {0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF};
+static const uint8_t candidateChannels[] = {1, 6, 11}; // the non-overlapping ones
+
+static uint8_t channel = 1;
+static bool scanRunning = false; // async scan from 'pair scan', see pairingPoll
+
+// A remote whose accept goes out plain. It is encrypted again once the
+// send callback has reported that frame, or after
+// PAIR_ACCEPT_SENT_TIMEOUT_MS should no callback come.
+static portMUX_TYPE acceptLock = portMUX_INITIALIZER_UNLOCKED;
+static uint8_t plainMac[6];
+static bool plainPending = false;
+static bool plainSent = false;
+static uint32_t plainSinceMs = 0;
+
+// Window state; pairingAccepts reads it from the WiFi task
+static volatile bool windowOpen = false;
+static volatile uint8_t windowRole = ROLE_CONTROL;
+static uint32_t windowEndMs = 0;
+static uint32_t windowSession = 0;
+static uint32_t beaconSeq = 0;
+static uint32_t lastBeaconMs = 0;
+
+// Statistics
+static uint32_t beaconsSent = 0;
+static uint32_t paired = 0;
+static uint32_t repaired = 0;
+
+static void applyChannel(uint8_t ch)
+{
+    channel = ch;
+    esp_wifi_set_channel(ch, WIFI_SECOND_CHAN_NONE);
+}
+
+// Picks, stores and switches to the best channel from a finished scan
+static void pickChannel(int16_t found)
+{
+    // Every AP loads its own channel and the two either side, stronger
+    // ones more. Scores are compared only for the candidates.
+    uint32_t score[14] = {0};
+    for (int16_t i = 0; i < found; i++)
+    {
+        int32_t ch = WiFi.channel(i);
+        uint32_t weight = (uint32_t)constrain(WiFi.RSSI(i) + 100, (int32_t)1, (int32_t)100);
+        for (int32_t c = ch - 2; c <= ch + 2; c++)
+            if (c >= 1 && c <= 13)
+                score[c] += (c == ch) ? weight * 2 : weight;
+    }
+    WiFi.scanDelete();
+
+    uint8_t best = candidateChannels[0];
+    for (size_t i = 0; i < sizeof(candidateChannels); i++)
+    {
+        uint8_t c = candidateChannels[i];
+        Serial.printf("Channel %2u: score %u\n", c, (unsigned)score[c]);
+        if (score[c] < score[best])
+            best = c;
+    }
+    Serial.printf("Scan: %d networks, using channel %u\n", found < 0 ? 0 : found, best);
+
+    Preferences prefs;
+    prefs.begin("hub", false);
+    prefs.putUChar("chan", best);
+    prefs.end();
+
+    applyChannel(best);
+}
+
+bool pairingStartScan()
+{
+    if (scanRunning)
+        return false;
+    // Async: the channel hops while it runs, pairingPoll() picks the result
+    if (WiFi.scanNetworks(true, true) == WIFI_SCAN_FAILED)
+    {
+        Serial.println("Scan: could not start");
+        applyChannel(channel);
+        return false;
+    }
+    scanRunning = true;
+    return true;
+}
+
+static void pollScan()
+{
+    if (!scanRunning)
+        return;
+    int16_t found = WiFi.scanComplete();
+    if (found == WIFI_SCAN_RUNNING)
+        return;
+    scanRunning = false;
+    if (found == WIFI_SCAN_FAILED)
+    {
+        Serial.println("Scan: failed, channel unchanged");
+        applyChannel(channel);
+        return;
+    }
+    pickChannel(found);
+    Serial.println("Paired remotes must pair again to follow the new channel.");
+}
+
+bool pairingScanning()
+{
+    return scanRunning;
+}
+
+uint8_t pairingChannel()
+{
+    return channel;
+}
+
+void pairingBegin()
+{
+    uint8_t stored = 0;
+    Preferences prefs;
+    if (prefs.begin("hub", true))
+    {
+        stored = prefs.getUChar("chan", 0);
+        prefs.end();
+    }
+
+    if (stored >= 1 && stored <= 13)
+        applyChannel(stored);
+    else
+        pickChannel(WiFi.scanNetworks(false, true)); // at boot, before any remote is served
+    Serial.printf("Radio channel %u\n", channel);
+}
+
+void pairingOpen(uint32_t seconds, uint8_t role)
+{
+    if (!esp_now_is_peer_exist(broadcastMac))
+    {
+        esp_now_peer_info_t peerInfo;
+        memset(&peerInfo, 0, sizeof(peerInfo));
+        memcpy(peerInfo.peer_addr, broadcastMac, 6);
+        peerInfo.channel = 0;
+        peerInfo.encrypt = false;
+        esp_now_add_peer(&peerInfo);
+    }
+
+    windowRole = role;
+    windowEndMs = millis() + seconds * 1000UL;
+    do
+    {
+        windowSession = esp_random();
+    } while (windowSession == 0);
+    beaconSeq = 0;
+    windowOpen = true;
+    Serial.printf("Pairing open for %u s on channel %u, new remotes get role %s\n",
+                  (unsigned)seconds, channel, peerRoleName(role));
+}
+
+void pairingClose()
+{
+    if (windowOpen)
+        Serial.println("Pairing closed");
+    windowOpen = false;
+}
+
+bool pairingIsOpen()
+{
+    return windowOpen;
+}
+
+bool pairingAccepts(const uint8_t *data, int len)
+{
+    return windowOpen && len == sizeof(pair_message) && data[0] == MSG_PAIR_REQUEST;
+}
+
+void pairingOnSent(const uint8_t *mac)
+{
+    portENTER_CRITICAL(&acceptLock);
+    if (plainPending && memcmp(mac, plainMac, 6) == 0)
+        plainSent = true;
+    portEXIT_CRITICAL(&acceptLock);
+}
+
+// Encrypts the remote of the last accept again once that frame is out
+static void restoreAccepted(bool now)
+{
+    uint8_t mac[6];
+    portENTER_CRITICAL(&acceptLock);
+    bool due = plainPending && (now || plainSent || millis() - plainSinceMs >= PAIR_ACCEPT_SENT_TIMEOUT_MS);
+    if (due)
+    {
+        memcpy(mac, plainMac, 6);
+        plainPending = false;
+    }
+    portEXIT_CRITICAL(&acceptLock);
+    if (due)
+        setEspNowPeerEncryption(mac, true);
+}
+
+void pairingHandleRequest(const uint8_t *mac, const uint8_t *data, int len)
+{
+    if (len != sizeof(pair_message))
+        return;
+    pair_message req;
+    memcpy(&req, data, sizeof(req));
+    if (req.hdr.version != PROTOCOL_VERSION)
+        return;
+
+    // Known remotes may re-pair at any time (e.g. after a channel change),
+    // new ones only while the window is open
+    peer_record_t rec;
+    if (peerTableLookup(mac, &rec))
+    {
+        repaired++;
+    }
+    else if (windowOpen && peerTableAdd(mac, windowRole))
+    {
+        peerTableLookup(mac, &rec);
+        paired++;
+        Serial.printf("Paired " MAC_FMT " as %s\n", MAC_ARGS(mac), peerRoleName(rec.role));
+    }
+    else
+    {
+        return;
+    }
+
+    pair_message accept;
+    memset(&accept, 0, sizeof(accept));
+    accept.hdr = req.hdr;
+    accept.hdr.type = MSG_PAIR_ACCEPT;
+    accept.channel = channel;
+    accept.role = rec.role;
+    // The remote listens in plain until it has the accept, so the accept
+    // goes out plain even to a remote with a key. Marked before sending,
+    // the send callback may come before esp_now_send() returns.
+    restoreAccepted(true);
+    if (!setEspNowPeerEncryption(mac, false))
+    {
+        Serial.println("Error sending pairing accept");
+        return;
+    }
+    portENTER_CRITICAL(&acceptLock);
+    memcpy(plainMac, mac, 6);
+    plainSent = false;
+    plainSinceMs = millis();
+    plainPending = true;
+    portEXIT_CRITICAL(&acceptLock);
+    if (esp_now_send(mac, (uint8_t *)&accept, sizeof(accept)) != ESP_OK)
+    {
+        Serial.println("Error sending pairing accept");
+        restoreAccepted(true);
+    }
+}
+
+void pairingPoll()
+{
+    restoreAccepted(false);
+    pollScan();
+    if (!windowOpen)
+        return;
+
+    uint32_t now = millis();
+    if ((int32_t)(now - windowEndMs) >= 0)
+    {
+        pairingClose();
+        return;
+    }
+    if (now - lastBeaconMs < PAIR_BEACON_INTERVAL_MS)
+        return;
+    lastBeaconMs = now;
+
+    pair_message beacon;
+    memset(&beacon, 0, sizeof(beacon));
+    beacon.hdr.type = MSG_PAIR_BEACON;
+    beacon.hdr.version = PROTOCOL_VERSION;
+    beacon.hdr.session = windowSession;
+    beacon.hdr.seq = ++beaconSeq;
+    beacon.channel = channel;
+    beacon.role = windowRole;
+    if (esp_now_send(broadcastMac, (uint8_t *)&beacon, sizeof(beacon)) == ESP_OK)
+        beaconsSent++;
+}
+
+void pairingPrint(Print &out)
+{
+    out.printf("Pairing: channel %u, window %s", channel, windowOpen ? "open" : "closed");
+    if (windowOpen)
+        out.printf(" (%u s left)", (unsigned)((windowEndMs - millis()) / 1000));
+    out.printf(", %u beacons, %u paired, %u re-paired\n", (unsigned)beaconsSent, (unsigned)paired,
+               (unsigned)repaired);
+}
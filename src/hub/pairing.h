@@ -0,0 +1,42 @@
+// File: src/hub/pairing.h
+// Radio channel selection and remote pairing on the hub.
+// The channel is picked once by scanning for the least crowded of 1, 6
+// and 11, then kept in NVS. While a pairing window is open the hub
+// broadcasts beacons and adds any remote that answers to the peer table.
+#pragma once
+
+#include <Arduino.h>
+#include "protocol.h"
+
+#define PAIR_DEFAULT_WINDOW_S 60
+#define PAIR_BEACON_INTERVAL_MS 100
+#define PAIR_ACCEPT_SENT_TIMEOUT_MS 100 // no send callback by then: encrypt anyway
+
+// Applies the stored channel, scanning first if there is none.
+// Call after WiFi.mode(WIFI_STA) and before esp_now_init().
+void pairingBegin();
+
+// Starts a background scan; pairingPoll() then stores and switches to
+// the best channel. Paired remotes have to pair again afterwards. False
+// if a scan is already running or could not start.
+bool pairingStartScan();
+bool pairingScanning();
+uint8_t pairingChannel();
+
+void pairingOpen(uint32_t seconds, uint8_t role);
+void pairingClose();
+bool pairingIsOpen();
+
+// True if OnDataRecv should queue this frame from an unknown sender
+bool pairingAccepts(const uint8_t *data, int len);
+
+// From the command task
+void pairingHandleRequest(const uint8_t *mac, const uint8_t *data, int len);
+// From the send callback, for every unicast frame
+void pairingOnSent(const uint8_t *mac);
+
+// Beacons, window timeout, channel scan and the accept's encryption,
+// from the scheduler
+void pairingPoll();
+
+void pairingPrint(Print &out);
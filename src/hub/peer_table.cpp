@@ -0,0 +1,290 @@
+// File: src/hub/peer_table.cpp
+#include "peer_table.h"
+#include <Preferences.h>
+#include "mac_util.h"
+
+#define SLOT_EMPTY 0xFF
+#define NVS_KEY_PEERS "peers2"
+#define NVS_KEY_PEERS_V1 "peers" // 8-byte records without keys
+
+typedef struct __attribute__((packed)) peer_record_v1_t
+{
+    uint8_t mac[6];
+    uint8_t role;
+    uint8_t reserved;
+} peer_record_v1_t;
+
+typedef struct peer_entry_t
+{
+    peer_record_t rec;
+    dedup_window_t window;
+} peer_entry_t;
+
+// Entries are kept dense, slots[] maps a hash bucket to an entry index
+static peer_entry_t entries[PEER_MAX];
+static uint8_t slots[PEER_HASH_SLOTS];
+static size_t entryCount = 0;
+
+// Short critical sections only: the WiFi callback takes this too
+static portMUX_TYPE peerLock = portMUX_INITIALIZER_UNLOCKED;
+
+static uint32_t hashMac(const uint8_t *mac)
+{
+    // FNV-1a over the 6 address bytes
+    uint32_t h = 2166136261UL;
+    for (int i = 0; i < 6; i++)
+    {
+        h ^= mac[i];
+        h *= 16777619UL;
+    }
+    return h;
+}
+
+// Returns the entry index or -1. Caller holds peerLock.
+static int findLocked(const uint8_t *mac)
+{
+    uint32_t slot = hashMac(mac) & (PEER_HASH_SLOTS - 1);
+    for (int probe = 0; probe < PEER_HASH_SLOTS; probe++)
+    {
+        uint8_t idx = slots[slot];
+        if (idx == SLOT_EMPTY)
+            return -1;
+        if (memcmp(entries[idx].rec.mac, mac, 6) == 0)
+            return idx;
+        slot = (slot + 1) & (PEER_HASH_SLOTS - 1);
+    }
+    return -1;
+}
+
+static void insertSlotLocked(uint8_t idx)
+{
+    uint32_t slot = hashMac(entries[idx].rec.mac) & (PEER_HASH_SLOTS - 1);
+    while (slots[slot] != SLOT_EMPTY)
+        slot = (slot + 1) & (PEER_HASH_SLOTS - 1);
+    slots[slot] = idx;
+}
+
+// Removal is rare (provisioning only) so the index is simply rebuilt
+static void rebuildSlotsLocked()
+{
+    memset(slots, SLOT_EMPTY, sizeof(slots));
+    for (size_t i = 0; i < entryCount; i++)
+        insertSlotLocked(i);
+}
+
+static void save()
+{
+    peer_record_t records[PEER_MAX];
+    size_t n;
+
+    portENTER_CRITICAL(&peerLock);
+    n = entryCount;
+    for (size_t i = 0; i < n; i++)
+        records[i] = entries[i].rec;
+    portEXIT_CRITICAL(&peerLock);
+
+    Preferences prefs;
+    prefs.begin("hub", false);
+    prefs.putBytes(NVS_KEY_PEERS, records, n * sizeof(peer_record_t));
+    prefs.end();
+}
+
+void peerTableBegin(const uint8_t *defaultMac)
+{
+    peer_record_t records[PEER_MAX];
+    size_t len = 0;
+    bool migrated = false;
+
+    Preferences prefs;
+    if (prefs.begin("hub", true))
+    {
+        len = prefs.getBytes(NVS_KEY_PEERS, records, sizeof(records));
+        if (len == 0 && prefs.isKey(NVS_KEY_PEERS_V1))
+        {
+            // Table saved before per-peer keys existed
+            peer_record_v1_t old[PEER_MAX];
+            size_t n = prefs.getBytes(NVS_KEY_PEERS_V1, old, sizeof(old)) / sizeof(peer_record_v1_t);
+            memset(records, 0, sizeof(records));
+            for (size_t i = 0; i < n; i++)
+            {
+                memcpy(records[i].mac, old[i].mac, 6);
+                records[i].role = old[i].role;
+            }
+            len = n * sizeof(peer_record_t);
+            migrated = true;
+        }
+        prefs.end();
+    }
+
+    memset(slots, SLOT_EMPTY, sizeof(slots));
+    entryCount = 0;
+    for (size_t i = 0; i < len / sizeof(peer_record_t); i++)
+    {
+        entries[entryCount].rec = records[i];
+        dedupReset(&entries[entryCount].window);
+        insertSlotLocked(entryCount);
+        entryCount++;
+    }
+
+    // Written in the new format once, then the old key goes; saved first
+    // so a reset in between only means migrating again
+    if (migrated)
+    {
+        save();
+        prefs.begin("hub", false);
+        prefs.remove(NVS_KEY_PEERS_V1);
+        prefs.end();
+        Serial.printf("Peer table: %u peer(s) migrated from the old format\n", (unsigned)entryCount);
+    }
+
+    // First boot: optional seed remote, otherwise remotes are paired
+    if (entryCount == 0 && defaultMac != NULL)
+        peerTableAdd(defaultMac, ROLE_CONTROL);
+}
+
+bool peerTableContains(const uint8_t *mac)
+{
+    portENTER_CRITICAL(&peerLock);
+    bool found = findLocked(mac) >= 0;
+    portEXIT_CRITICAL(&peerLock);
+    return found;
+}
+
+bool peerTableCheck(const uint8_t *mac, uint32_t session, uint32_t seq, peer_admit_t *out)
+{
+    portENTER_CRITICAL(&peerLock);
+    int idx = findLocked(mac);
+    if (idx >= 0)
+    {
+        out->role = entries[idx].rec.role;
+        out->dedup = dedupCheck(&entries[idx].window, session, seq);
+    }
+    portEXIT_CRITICAL(&peerLock);
+    return idx >= 0;
+}
+
+bool peerTableAdd(const uint8_t *mac, uint8_t role)
+{
+    if (role != ROLE_CONTROL && role != ROLE_READ_ONLY)
+        return false;
+
+    portENTER_CRITICAL(&peerLock);
+    int idx = findLocked(mac);
+    bool ok = true;
+    if (idx >= 0)
+    {
+        entries[idx].rec.role = role;
+    }
+    else if (entryCount < PEER_MAX)
+    {
+        peer_entry_t *e = &entries[entryCount];
+        memset(e, 0, sizeof(*e));
+        memcpy(e->rec.mac, mac, 6);
+        e->rec.role = role;
+        dedupReset(&e->window);
+        insertSlotLocked(entryCount);
+        entryCount++;
+    }
+    else
+    {
+        ok = false;
+    }
+    portEXIT_CRITICAL(&peerLock);
+
+    if (ok)
+        save();
+    return ok;
+}
+
+bool peerTableRemove(const uint8_t *mac)
+{
+    portENTER_CRITICAL(&peerLock);
+    int idx = findLocked(mac);
+    if (idx >= 0)
+    {
+        entries[idx] = entries[entryCount - 1];
+        entryCount--;
+        rebuildSlotsLocked();
+    }
+    portEXIT_CRITICAL(&peerLock);
+
+    if (idx < 0)
+        return false;
+    save();
+    return true;
+}
+
+bool peerTableSetKey(const uint8_t *mac, const uint8_t *lmk)
+{
+    portENTER_CRITICAL(&peerLock);
+    int idx = findLocked(mac);
+    if (idx >= 0)
+    {
+        peer_record_t *rec = &entries[idx].rec;
+        if (lmk != NULL)
+        {
+            memcpy(rec->lmk, lmk, sizeof(rec->lmk));
+            rec->flags |= PEER_FLAG_ENCRYPT;
+        }
+        else
+        {
+            memset(rec->lmk, 0, sizeof(rec->lmk));
+            rec->flags &= ~PEER_FLAG_ENCRYPT;
+        }
+    }
+    portEXIT_CRITICAL(&peerLock);
+
+    if (idx < 0)
+        return false;
+    save();
+    return true;
+}
+
+bool peerTableLookup(const uint8_t *mac, peer_record_t *out)
+{
+    portENTER_CRITICAL(&peerLock);
+    int idx = findLocked(mac);
+    if (idx >= 0)
+        *out = entries[idx].rec;
+    portEXIT_CRITICAL(&peerLock);
+    return idx >= 0;
+}
+
+size_t peerTableCount()
+{
+    return entryCount;
+}
+
+bool peerTableGet(size_t index, peer_record_t *out)
+{
+    portENTER_CRITICAL(&peerLock);
+    bool ok = index < entryCount;
+    if (ok)
+        *out = entries[index].rec;
+    portEXIT_CRITICAL(&peerLock);
+    return ok;
+}
+
+void peerTablePrint(Print &out)
+{
+    peer_record_t rec;
+    out.printf("Peers: %u/%u\n", (unsigned)entryCount, PEER_MAX);
+    for (size_t i = 0; peerTableGet(i, &rec); i++)
+    {
+        out.printf("  " MAC_FMT "  %-9s  %s\n", MAC_ARGS(rec.mac), peerRoleName(rec.role),
+                   (rec.flags & PEER_FLAG_ENCRYPT) ? "encrypted" : "plain");
+    }
+}
+
+const char *peerRoleName(uint8_t role)
+{
+    switch (role)
+    {
+    case ROLE_CONTROL:
+        return "control";
+    case ROLE_READ_ONLY:
+        return "read-only";
+    default:
+        return "?";
+    }
+}
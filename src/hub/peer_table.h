@@ -0,0 +1,53 @@
+// File: src/hub/peer_table.h
+// Allowlist of remotes that may talk to the Hub.
+// Open-addressed hash on the MAC address, so every received frame costs
+// one hash and (almost always) one compare. Persisted to NVS as a single
+// blob so boot is one read.
+#pragma once
+
+#include <Arduino.h>
+#include "dedup_window.h"
+#include "protocol.h"
+
+#define PEER_MAX 32
+#define PEER_HASH_SLOTS 64 // power of two, keeps the load factor <= 50%
+
+// --- PEER FLAGS ---
+#define PEER_FLAG_ENCRYPT 0x01 // lmk is valid, talk to this peer encrypted
+
+// What is stored in NVS for each peer
+typedef struct __attribute__((packed)) peer_record_t
+{
+    uint8_t mac[6];
+    uint8_t role;
+    uint8_t flags;
+    uint8_t lmk[16];
+} peer_record_t;
+
+// Result of peerTableCheck for one received command
+typedef struct peer_admit_t
+{
+    uint8_t role;
+    dedup_result_t dedup;
+} peer_admit_t;
+
+void peerTableBegin(const uint8_t *defaultMac);
+
+// Cheap membership test, safe to call from the WiFi callback
+bool peerTableContains(const uint8_t *mac);
+
+// Looks up the sender and runs its duplicate filter in one step
+bool peerTableCheck(const uint8_t *mac, uint32_t session, uint32_t seq, peer_admit_t *out);
+
+// Provisioning, both persist the table to NVS
+bool peerTableAdd(const uint8_t *mac, uint8_t role);
+bool peerTableRemove(const uint8_t *mac);
+bool peerTableSetKey(const uint8_t *mac, const uint8_t *lmk); // NULL clears
+
+bool peerTableLookup(const uint8_t *mac, peer_record_t *out);
+
+size_t peerTableCount();
+bool peerTableGet(size_t index, peer_record_t *out);
+void peerTablePrint(Print &out);
+
+const char *peerRoleName(uint8_t role);
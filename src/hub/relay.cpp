@@ -0,0 +1,396 @@
+// File: src/hub/relay.cpp
+#include "relay.h"
+#include "protocol.h"
+#include "telemetry.h"
+#include "soc/soc.h"
+#include "soc/gpio_reg.h"
+
+#define DUTY_BUCKET_MS 60000UL
+#define DUTY_BUCKETS 60 // one hour of one-minute buckets
+
+typedef struct zone_state_t
+{
+    uint8_t state;
+    uint32_t onSinceMs;
+    uint32_t runMs; // 0 = open-ended
+    uint32_t offSinceMs;
+
+    // Statistics
+    uint32_t starts;
+    uint32_t watchdogTrips;
+    uint64_t totalOnMs;
+    uint32_t longestRunMs;
+} zone_state_t;
+
+static zone_state_t zones[ZONE_COUNT];
+static uint8_t openMask = 0; // shadow of the outputs
+static uint32_t anyOnSinceMs = 0;
+
+static uint32_t lockoutRejects = 0;
+static uint32_t interlockRejects = 0;
+static uint32_t bankWrites = 0;
+
+// Rolling duty cycle: time any zone was open, per minute for the last hour
+static uint16_t dutyBuckets[DUTY_BUCKETS];
+static uint8_t dutyIndex = 0;
+static uint32_t dutyBucketStartMs = 0;
+static uint32_t dutyAccountedMs = 0; // last time on-time was added
+static bool dutyWindowFull = false;
+
+// Called from the command task and the scheduler
+static portMUX_TYPE relayLock = portMUX_INITIALIZER_UNLOCKED;
+
+// Drives every zone pin from the shadow mask. Set and clear are single
+// register writes that leave other GPIOs alone; closing zones go first so
+// a zone change never has both zones open for a moment.
+static void writeOutputs(uint8_t mask)
+{
+    uint32_t on = zonePinMask(mask);
+    uint32_t off = ZONE_PIN_MASK & ~on;
+    if (ZONE_ACTIVE_LOW)
+    {
+        REG_WRITE(GPIO_OUT_W1TS_REG, off);
+        REG_WRITE(GPIO_OUT_W1TC_REG, on);
+    }
+    else
+    {
+        REG_WRITE(GPIO_OUT_W1TC_REG, off);
+        REG_WRITE(GPIO_OUT_W1TS_REG, on);
+    }
+    bankWrites++;
+}
+
+// Adds on-time up to now into the duty buckets. Caller holds relayLock.
+static void accountLocked(uint32_t now)
+{
+    bool on = openMask != 0;
+    while (now - dutyBucketStartMs >= DUTY_BUCKET_MS)
+    {
+        uint32_t bucketEnd = dutyBucketStartMs + DUTY_BUCKET_MS;
+        if (on)
+            dutyBuckets[dutyIndex] += bucketEnd - dutyAccountedMs;
+        dutyAccountedMs = bucketEnd;
+        dutyBucketStartMs = bucketEnd;
+        dutyIndex = (dutyIndex + 1) % DUTY_BUCKETS;
+        dutyBuckets[dutyIndex] = 0;
+        if (dutyIndex == 0)
+            dutyWindowFull = true;
+    }
+    if (on)
+        dutyBuckets[dutyIndex] += now - dutyAccountedMs;
+    dutyAccountedMs = now;
+}
+
+static uint8_t lockedOutMask()
+{
+    uint8_t mask = 0;
+    for (uint8_t i = 0; i < ZONE_COUNT; i++)
+        if (zones[i].state == RELAY_LOCKOUT)
+            mask |= 1 << i;
+    return mask;
+}
+
+// Moves the bank to newMask in one output write. Newly opened zones get
+// runMs as their timer, closed zones go into lockout. Caller holds
+// relayLock and has already checked lockout and the interlock.
+static void applyLocked(uint8_t newMask, uint32_t now, uint32_t runMs)
+{
+    accountLocked(now);
+    if (openMask == 0 && newMask != 0)
+        anyOnSinceMs = now;
+
+    for (uint8_t i = 0; i < ZONE_COUNT; i++)
+    {
+        zone_state_t *z = &zones[i];
+        bool wasOn = openMask & (1 << i);
+        bool isOn = newMask & (1 << i);
+        if (isOn && !wasOn)
+        {
+            z->state = RELAY_ON;
+            z->onSinceMs = now;
+            z->runMs = runMs;
+            z->starts++;
+        }
+        else if (wasOn && !isOn)
+        {
+            uint32_t ran = now - z->onSinceMs;
+            z->totalOnMs += ran;
+            if (ran > z->longestRunMs)
+                z->longestRunMs = ran;
+            z->state = RELAY_LOCKOUT;
+            z->offSinceMs = now;
+        }
+    }
+
+    openMask = newMask;
+    writeOutputs(newMask);
+}
+
+// Checks lockout and the interlock for a change from openMask to newMask.
+// Caller holds relayLock.
+static uint8_t checkLocked(uint8_t newMask)
+{
+    if ((newMask & ~openMask) & lockedOutMask())
+    {
+        lockoutRejects++;
+        return ACK_LOCKOUT;
+    }
+    if (__builtin_popcount(newMask) > ZONE_MAX_OPEN)
+    {
+        interlockRejects++;
+        return ACK_INTERLOCK;
+    }
+    return ACK_OK;
+}
+
+static void printZones(const char *action, uint8_t mask)
+{
+    Serial.printf("Action: %s", action);
+    for (uint8_t i = 0; i < ZONE_COUNT; i++)
+        if (mask & (1 << i))
+            Serial.printf(" [%s]", ZONES[i].name);
+}
+
+static void report(uint8_t status, const char *action, uint8_t mask, uint32_t durationMs = 0)
+{
+    if (status == ACK_LOCKOUT)
+        Serial.println("Action: Zone locked out (minimum off-time)");
+    else if (status == ACK_INTERLOCK)
+        Serial.printf("Action: Interlock, at most %u zone(s) open\n", (unsigned)ZONE_MAX_OPEN);
+    else if (status == ACK_UNKNOWN)
+        Serial.println("Action: No such zone");
+    else if (status == ACK_TOO_LONG)
+        Serial.printf("Action: Run refused, at most %u min\n", (unsigned)(RELAY_MAX_RUNTIME_MS / 60000UL));
+    else
+    {
+        printZones(action, mask);
+        if (durationMs != 0)
+            Serial.printf(" for %u s", (unsigned)(durationMs / 1000));
+        Serial.println();
+    }
+}
+
+void relayBegin()
+{
+    // Drive OFF before enabling the outputs so no zone blips at boot
+    writeOutputs(0);
+    for (uint8_t i = 0; i < ZONE_COUNT; i++)
+        pinMode(ZONES[i].pin, OUTPUT);
+    writeOutputs(0);
+
+    uint32_t now = millis();
+    openMask = 0;
+    memset(zones, 0, sizeof(zones));
+    dutyBucketStartMs = now;
+    dutyAccountedMs = now;
+    memset(dutyBuckets, 0, sizeof(dutyBuckets));
+}
+
+uint8_t relayStart(uint8_t mask, uint32_t durationMs)
+{
+    if (mask == 0 || (mask & ~ZONE_ALL_MASK))
+    {
+        report(ACK_UNKNOWN, NULL, 0);
+        return ACK_UNKNOWN;
+    }
+    if (durationMs > RELAY_MAX_RUNTIME_MS)
+    {
+        report(ACK_TOO_LONG, NULL, 0);
+        return ACK_TOO_LONG;
+    }
+
+    uint32_t now = millis();
+    uint8_t status;
+    bool changed = false;
+
+    portENTER_CRITICAL(&relayLock);
+    uint8_t newMask = openMask | mask;
+    status = checkLocked(newMask);
+    if (status == ACK_OK)
+    {
+        changed = newMask != openMask;
+        // Already running zones restart their timer from now
+        for (uint8_t i = 0; i < ZONE_COUNT; i++)
+            if ((mask & openMask) & (1 << i))
+                zones[i].runMs = (durationMs == 0) ? 0 : (now - zones[i].onSinceMs) + durationMs;
+        applyLocked(newMask, now, durationMs);
+    }
+    portEXIT_CRITICAL(&relayLock);
+
+    report(status, "ON", mask, durationMs);
+    if (changed)
+        telemetryNotifyChange();
+    return status;
+}
+
+uint8_t relayStop(uint8_t mask)
+{
+    if (mask == 0 || (mask & ~ZONE_ALL_MASK))
+    {
+        report(ACK_UNKNOWN, NULL, 0);
+        return ACK_UNKNOWN;
+    }
+
+    bool changed = false;
+
+    portENTER_CRITICAL(&relayLock);
+    if (openMask & mask)
+    {
+        applyLocked(openMask & ~mask, millis(), 0);
+        changed = true;
+    }
+    portEXIT_CRITICAL(&relayLock);
+
+    report(ACK_OK, "OFF", mask);
+    if (changed)
+        telemetryNotifyChange();
+    return ACK_OK;
+}
+
+uint8_t relayToggle(uint8_t mask)
+{
+    // Any of the zones open counts as on, so a group toggles together
+    return (relayOpenMask() & mask) ? relayStop(mask) : relayStart(mask, 0);
+}
+
+uint8_t relaySet(uint8_t mask)
+{
+    if (mask & ~ZONE_ALL_MASK)
+    {
+        report(ACK_UNKNOWN, NULL, 0);
+        return ACK_UNKNOWN;
+    }
+
+    uint8_t status;
+    bool changed = false;
+
+    portENTER_CRITICAL(&relayLock);
+    status = checkLocked(mask);
+    if (status == ACK_OK && mask != openMask)
+    {
+        applyLocked(mask, millis(), 0);
+        changed = true;
+    }
+    portEXIT_CRITICAL(&relayLock);
+
+    report(status, "SET", mask);
+    if (changed)
+        telemetryNotifyChange();
+    return status;
+}
+
+bool relayIsOn()
+{
+    return openMask != 0;
+}
+
+uint8_t relayOpenMask()
+{
+    return openMask;
+}
+
+uint8_t relayState(uint8_t zone)
+{
+    return zone < ZONE_COUNT ? zones[zone].state : RELAY_OFF;
+}
+
+void relayTick()
+{
+    uint32_t now = millis();
+    uint8_t timedOut = 0;
+    uint8_t watchdog = 0;
+
+    portENTER_CRITICAL(&relayLock);
+    for (uint8_t i = 0; i < ZONE_COUNT; i++)
+    {
+        zone_state_t *z = &zones[i];
+        if (z->state == RELAY_ON)
+        {
+            uint32_t ran = now - z->onSinceMs;
+            if (ran >= RELAY_MAX_RUNTIME_MS)
+            {
+                z->watchdogTrips++;
+                watchdog |= 1 << i;
+            }
+            else if (z->runMs != 0 && ran >= z->runMs)
+            {
+                timedOut |= 1 << i;
+            }
+        }
+        else if (z->state == RELAY_LOCKOUT && now - z->offSinceMs >= RELAY_MIN_OFF_MS)
+        {
+            z->state = RELAY_OFF;
+        }
+    }
+    if (watchdog | timedOut)
+        applyLocked(openMask & ~(watchdog | timedOut), now, 0);
+    else
+        accountLocked(now);
+    portEXIT_CRITICAL(&relayLock);
+
+    if (watchdog)
+    {
+        printZones("OFF (watchdog, maximum runtime reached)", watchdog);
+        Serial.println();
+    }
+    if (timedOut)
+    {
+        printZones("OFF (timed run finished)", timedOut);
+        Serial.println();
+    }
+    if (watchdog | timedOut)
+        telemetryNotifyChange();
+}
+
+uint16_t relayDutyPermille()
+{
+    uint32_t sum = 0;
+    uint32_t window;
+    portENTER_CRITICAL(&relayLock);
+    for (int i = 0; i < DUTY_BUCKETS; i++)
+        sum += dutyBuckets[i];
+    // Before the first hour is up, divide by the time actually covered
+    if (dutyWindowFull)
+        window = (DUTY_BUCKETS - 1) * DUTY_BUCKET_MS + (dutyAccountedMs - dutyBucketStartMs);
+    else
+        window = dutyIndex * DUTY_BUCKET_MS + (dutyAccountedMs - dutyBucketStartMs);
+    portEXIT_CRITICAL(&relayLock);
+
+    if (window == 0)
+        return 0;
+    return (uint16_t)min((uint64_t)sum * 1000 / window, (uint64_t)1000);
+}
+
+void relayPrintStats(Print &out)
+{
+    static const char *names[] = {"OFF", "ON", "LOCKOUT"};
+    uint32_t now = millis();
+    uint64_t anyOnMs = 0;
+
+    out.printf("Relay bank: %u zone(s), open mask 0x%02X, max open %u\n",
+               (unsigned)ZONE_COUNT, openMask, (unsigned)ZONE_MAX_OPEN);
+    for (uint8_t i = 0; i < ZONE_COUNT; i++)
+    {
+        const zone_state_t *z = &zones[i];
+        uint64_t onMs = z->totalOnMs + (z->state == RELAY_ON ? now - z->onSinceMs : 0);
+        anyOnMs += onMs;
+
+        out.printf("  %-8s GPIO%-2u %s", ZONES[i].name, ZONES[i].pin, names[z->state]);
+        if (z->state == RELAY_ON)
+        {
+            out.printf(" for %u s", (unsigned)((now - z->onSinceMs) / 1000));
+            if (z->runMs != 0)
+                out.printf(" of %u s", (unsigned)(z->runMs / 1000));
+        }
+        out.println();
+        out.printf("           starts %u, on-time %u s, longest run %u s, watchdog trips %u\n",
+                   (unsigned)z->starts, (unsigned)(onMs / 1000), (unsigned)(z->longestRunMs / 1000),
+                   (unsigned)z->watchdogTrips);
+    }
+    out.printf("  duty last hour %.1f %%, zone-seconds since boot %u\n",
+               relayDutyPermille() / 10.0f, (unsigned)(anyOnMs / 1000));
+    if (openMask)
+        out.printf("  water on for %u s\n", (unsigned)((now - anyOnSinceMs) / 1000));
+    out.printf("  bank writes %u, lockout rejects %u, interlock rejects %u\n",
+               (unsigned)bankWrites, (unsigned)lockoutRejects, (unsigned)interlockRejects);
+}
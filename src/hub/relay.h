@@ -0,0 +1,41 @@
+// File: src/hub/relay.h
+// Relay bank state machine, one output per zone (see zones.h).
+// Outputs are driven from a shadow state and never read back from the
+// pins; all zones switch together in one GPIO register write. Timed
+// runs, the max-runtime watchdog and the minimum off-time are tracked
+// per zone and checked by relayTick() from the hub scheduler.
+#pragma once
+
+#include <Arduino.h>
+#include "zones.h"
+
+#define RELAY_MAX_RUNTIME_MS (30UL * 60UL * 1000UL) // watchdog: never run longer
+#define RELAY_MIN_OFF_MS (15UL * 1000UL)             // rest between runs
+#define RELAY_TICK_MS 50
+
+// --- RELAY STATES ---
+#define RELAY_OFF 0
+#define RELAY_ON 1
+#define RELAY_LOCKOUT 2 // off, waiting out RELAY_MIN_OFF_MS
+
+void relayBegin();
+
+// These take a zone mask and return an ACK_* status. A command is applied
+// to all of its zones or to none. durationMs 0 = until switched off
+// (still bounded by the watchdog); a longer run than the watchdog allows
+// is refused with ACK_TOO_LONG.
+uint8_t relayStart(uint8_t zones, uint32_t durationMs);
+uint8_t relayStop(uint8_t zones);
+uint8_t relayToggle(uint8_t zones);
+uint8_t relaySet(uint8_t zones); // open exactly these zones, close the rest
+
+bool relayIsOn();        // any zone open
+uint8_t relayOpenMask(); // bit per open zone
+uint8_t relayState(uint8_t zone);
+
+// Drives timers and statistics
+void relayTick();
+
+// Share of the last hour any zone was open, 0..1000
+uint16_t relayDutyPermille();
+void relayPrintStats(Print &out);
@@ -0,0 +1,641 @@
+// File: src/hub/rules.cpp
+#include "rules.h"
+#include "relay.h"
+#include <Preferences.h>
+
+#define RULE_HEADER_LEN 4
+#define RULE_BLOB_LEN(c, r) (RULE_HEADER_LEN + (c) * sizeof(rule_cond_t) + (r) * sizeof(rule_t))
+#define RAIN_AGE_MAX_MIN 32767
+
+typedef struct input_def_t
+{
+    const char *name;
+    float scale; // console units -> stored units
+} input_def_t;
+
+static const input_def_t inputDefs[IN_COUNT] = {
+    {"temp", 100.0f},    // degC
+    {"hum", 100.0f},     // %RH
+    {"pressure", 10.0f}, // hPa
+    {"lux", 1.0f},
+    {"rain", 1.0f},
+    {"rain_age", 1.0f}, // minutes, or <n>h
+    {"time", 1.0f},     // HH:MM
+};
+
+static const char *opNames[] = {"<", "<=", ">", ">=", "==", "!="};
+static const char *actionNames[] = {"run", "inhibit", "stop"};
+
+// Skip watering after rain, stop when it rains, water at dawn when dry.
+// Shipped disabled: automatic watering is switched on from the console.
+static const rule_table_t defaultTable = {
+    RULE_TABLE_VERSION,
+    5,
+    3,
+    0,
+    {
+        {IN_RAIN, CMP_EQ, 1},
+        {IN_RAIN_AGE, CMP_LT, 6 * 60},
+        {IN_TIME, CMP_GE, 5 * 60 + 30},
+        {IN_TIME, CMP_LT, 7 * 60},
+        {IN_HUMIDITY, CMP_LT, 4000},
+    },
+    {
+        {0x0002, RULE_INHIBIT, ZONE_ALL_MASK, 0, 0},
+        {0x0001, RULE_STOP, ZONE_ALL_MASK, 0, 0},
+        {0x001C, RULE_RUN, ZONE_DEFAULT_MASK, 300, 12 * 60},
+    },
+};
+
+static rule_table_t table;
+static uint16_t inputConds[IN_COUNT]; // conditions reading each input
+
+// Evaluation state
+static int16_t inputs[IN_COUNT];
+static uint16_t inputValid = 0;
+static uint16_t condTrue = 0;
+static uint16_t ruleTrue = 0;
+static bool primed = false;
+static uint32_t lastFiredMs[RULE_MAX_RULES];
+static uint16_t hasFired = 0;
+
+// Derived inputs
+static bool everWet = false;
+static uint32_t lastWetMs = 0;
+static bool clockValid = false;
+static int clockMinute = 0;
+static uint32_t clockSetMs = 0;
+
+// Statistics
+static uint32_t samples = 0;
+static uint32_t evaluations = 0; // samples that changed an input
+static uint32_t condEvals = 0;
+static uint32_t ruleEvals = 0;
+static uint32_t fires = 0;
+static uint32_t suppressed = 0; // cooldown or inhibit
+static uint32_t lastUs = 0;
+static uint32_t maxUs = 0;
+static uint64_t totalUs = 0;
+
+static bool tableValid(const rule_table_t *t)
+{
+    if (t->version != RULE_TABLE_VERSION || t->condCount > RULE_MAX_CONDS || t->ruleCount > RULE_MAX_RULES)
+        return false;
+    for (uint8_t i = 0; i < t->condCount; i++)
+        if (t->cond[i].input >= IN_COUNT || t->cond[i].op > CMP_NE)
+            return false;
+    uint16_t condMask = (uint16_t)((1UL << t->condCount) - 1);
+    for (uint8_t i = 0; i < t->ruleCount; i++)
+    {
+        const rule_t *r = &t->rule[i];
+        if (r->conds == 0 || (r->conds & ~condMask) || r->action > RULE_STOP ||
+            r->zones == 0 || (r->zones & ~ZONE_ALL_MASK))
+            return false;
+        if (r->action == RULE_RUN && (r->arg == 0 || r->arg * 1000UL > RELAY_MAX_RUNTIME_MS))
+            return false;
+    }
+    return true;
+}
+
+static bool compare(int16_t a, uint8_t op, int16_t b)
+{
+    switch (op)
+    {
+    case CMP_LT:
+        return a < b;
+    case CMP_LE:
+        return a <= b;
+    case CMP_GT:
+        return a > b;
+    case CMP_GE:
+        return a >= b;
+    case CMP_EQ:
+        return a == b;
+    default:
+        return a != b;
+    }
+}
+
+static bool condTrueNow(const rule_cond_t *c)
+{
+    return (inputValid & (1 << c->input)) && compare(inputs[c->input], c->op, c->value);
+}
+
+// Same action on the same conditions in the old and new table
+static bool ruleUnchanged(const rule_table_t *old, const rule_table_t *t, uint8_t i)
+{
+    if (i >= old->ruleCount || memcmp(&old->rule[i], &t->rule[i], sizeof(rule_t)) != 0)
+        return false;
+    for (uint8_t c = 0; c < RULE_MAX_CONDS; c++)
+        if ((t->rule[i].conds & (1 << c)) && memcmp(&old->cond[c], &t->cond[c], sizeof(rule_cond_t)) != 0)
+            return false;
+    return true;
+}
+
+// Installs t. Rules kept from the old table keep their cooldown; all of
+// them start from what the latest sample says, so an edit never makes a
+// rule that is already true fire again. Before the first sample the
+// next one evaluates everything (and fires what is true) as at boot.
+static void install(const rule_table_t *t)
+{
+    uint16_t keep = 0;
+    for (uint8_t i = 0; i < t->ruleCount; i++)
+        if (ruleUnchanged(&table, t, i))
+            keep |= 1 << i;
+    hasFired &= keep;
+
+    table = *t;
+    memset(inputConds, 0, sizeof(inputConds));
+    for (uint8_t i = 0; i < table.condCount; i++)
+        inputConds[table.cond[i].input] |= 1 << i;
+
+    condTrue = 0;
+    ruleTrue = 0;
+    primed = samples > 0;
+    if (!primed)
+        return;
+    for (uint8_t i = 0; i < table.condCount; i++)
+        if (condTrueNow(&table.cond[i]))
+            condTrue |= 1 << i;
+    for (uint8_t i = 0; i < table.ruleCount; i++)
+        if ((condTrue & table.rule[i].conds) == table.rule[i].conds)
+            ruleTrue |= 1 << i;
+}
+
+static void saveTable()
+{
+    uint8_t blob[sizeof(rule_table_t)];
+    size_t condBytes = table.condCount * sizeof(rule_cond_t);
+    size_t ruleBytes = table.ruleCount * sizeof(rule_t);
+    memcpy(blob, &table, RULE_HEADER_LEN);
+    memcpy(blob + RULE_HEADER_LEN, table.cond, condBytes);
+    memcpy(blob + RULE_HEADER_LEN + condBytes, table.rule, ruleBytes);
+
+    Preferences prefs;
+    prefs.begin("hub", false);
+    prefs.putBytes("rules", blob, RULE_BLOB_LEN(table.condCount, table.ruleCount));
+    prefs.end();
+}
+
+void rulesBegin()
+{
+    uint8_t blob[sizeof(rule_table_t)];
+    size_t len = 0;
+    rule_table_t t;
+
+    Preferences prefs;
+    if (prefs.begin("hub", true))
+    {
+        len = prefs.getBytesLength("rules");
+        if (len >= RULE_HEADER_LEN && len <= sizeof(blob))
+            len = prefs.getBytes("rules", blob, len);
+        else
+            len = 0;
+        prefs.end();
+    }
+
+    memset(&t, 0, sizeof(t));
+    if (len >= RULE_HEADER_LEN)
+    {
+        memcpy(&t, blob, RULE_HEADER_LEN);
+        if (t.condCount <= RULE_MAX_CONDS && t.ruleCount <= RULE_MAX_RULES &&
+            len == RULE_BLOB_LEN(t.condCount, t.ruleCount))
+        {
+            size_t condBytes = t.condCount * sizeof(rule_cond_t);
+            memcpy(t.cond, blob + RULE_HEADER_LEN, condBytes);
+            memcpy(t.rule, blob + RULE_HEADER_LEN + condBytes, t.ruleCount * sizeof(rule_t));
+        }
+    }
+
+    if (len >= RULE_HEADER_LEN && tableValid(&t))
+    {
+        install(&t);
+    }
+    else
+    {
+        if (len != 0)
+            Serial.println("Rules: stored table invalid, using defaults");
+        install(&defaultTable);
+    }
+    Serial.printf("Rules: %u condition(s), %u rule(s), %s\n",
+                  table.condCount, table.ruleCount, table.enabled ? "enabled" : "disabled");
+}
+
+void rulesSetClock(int minuteOfDay)
+{
+    clockValid = minuteOfDay >= 0;
+    clockMinute = minuteOfDay;
+    clockSetMs = millis();
+}
+
+int rulesClock()
+{
+    if (!clockValid)
+        return -1;
+    return (int)((clockMinute + (millis() - clockSetMs) / 60000UL) % (24 * 60));
+}
+
+// Turns a sample into rule inputs, returns the valid mask
+static uint16_t readInputs(const sensor_sample_t *s, int16_t *v)
+{
+    uint16_t valid = 0;
+    uint32_t now = millis();
+
+    if (!(s->flags & SAMPLE_FLAG_NO_BME))
+    {
+        v[IN_TEMP] = s->tempCenti;
+        v[IN_HUMIDITY] = (int16_t)s->humidityCenti;
+        v[IN_PRESSURE] = (int16_t)min(s->pressurePa / 10, (uint32_t)INT16_MAX);
+        valid |= (1 << IN_TEMP) | (1 << IN_HUMIDITY) | (1 << IN_PRESSURE);
+    }
+    if (!(s->flags & SAMPLE_FLAG_NO_LIGHT))
+    {
+        v[IN_LUX] = (int16_t)min(s->lux, (uint16_t)INT16_MAX);
+        valid |= 1 << IN_LUX;
+    }
+
+    bool wet = s->rain == LOW;
+    v[IN_RAIN] = wet ? 1 : 0;
+    valid |= 1 << IN_RAIN;
+    if (wet)
+    {
+        everWet = true;
+        lastWetMs = now;
+    }
+    if (everWet)
+    {
+        v[IN_RAIN_AGE] = (int16_t)min((uint32_t)((now - lastWetMs) / 60000UL), (uint32_t)RAIN_AGE_MAX_MIN);
+        valid |= 1 << IN_RAIN_AGE;
+    }
+
+    int minute = rulesClock();
+    if (minute >= 0)
+    {
+        v[IN_TIME] = (int16_t)minute;
+        valid |= 1 << IN_TIME;
+    }
+    return valid;
+}
+
+static void fire(uint8_t index, uint8_t inhibit)
+{
+    const rule_t *r = &table.rule[index];
+    uint32_t now = millis();
+
+    if (r->action == RULE_INHIBIT)
+        return;
+    if ((hasFired & (1 << index)) && now - lastFiredMs[index] < r->cooldownMin * 60000UL)
+    {
+        suppressed++;
+        Serial.printf("Rule %u: true, cooling down\n", index);
+        return;
+    }
+
+    uint8_t zones = r->zones;
+    if (r->action == RULE_RUN)
+        zones &= ~inhibit;
+    else
+        zones &= relayOpenMask();
+    if (zones == 0)
+    {
+        if (r->action == RULE_RUN)
+        {
+            suppressed++;
+            Serial.printf("Rule %u: true, inhibited\n", index);
+        }
+        return;
+    }
+
+    fires++;
+    hasFired |= 1 << index;
+    lastFiredMs[index] = now;
+    Serial.printf("Rule %u: %s\n", index, actionNames[r->action]);
+    if (r->action == RULE_RUN)
+        relayStart(zones, r->arg * 1000UL);
+    else
+        relayStop(zones);
+}
+
+void rulesOnSample(const sensor_sample_t *sample)
+{
+    // Inputs are tracked even while disabled so rain_age stays right
+    int16_t v[IN_COUNT] = {0};
+    uint32_t start = micros();
+    uint16_t valid = readInputs(sample, v);
+    samples++;
+
+    uint16_t changed = valid ^ inputValid;
+    for (uint8_t i = 0; i < IN_COUNT; i++)
+        if ((valid & (1 << i)) && v[i] != inputs[i])
+            changed |= 1 << i;
+    memcpy(inputs, v, sizeof(inputs));
+    inputValid = valid;
+
+    if (!table.enabled)
+        return;
+    if (!primed)
+        changed = (1 << IN_COUNT) - 1;
+    if (changed == 0)
+        return;
+
+    // Recompute only the conditions that read a changed input
+    uint16_t dirty = 0;
+    for (uint8_t i = 0; i < IN_COUNT; i++)
+        if (changed & (1 << i))
+            dirty |= inputConds[i];
+
+    uint16_t conds = condTrue;
+    for (uint8_t i = 0; i < table.condCount; i++)
+    {
+        if (!(dirty & (1 << i)))
+            continue;
+        const rule_cond_t *c = &table.cond[i];
+        bool result = condTrueNow(c);
+        conds = result ? (conds | (1 << i)) : (conds & ~(1 << i));
+        condEvals++;
+    }
+    uint16_t flipped = (conds ^ condTrue) | (primed ? 0 : 0xFFFF);
+    condTrue = conds;
+
+    // Then only the rules that use a condition which flipped
+    uint16_t rules = ruleTrue;
+    for (uint8_t i = 0; i < table.ruleCount; i++)
+    {
+        const rule_t *r = &table.rule[i];
+        if (!(r->conds & flipped))
+            continue;
+        bool result = (condTrue & r->conds) == r->conds;
+        rules = result ? (rules | (1 << i)) : (rules & ~(1 << i));
+        ruleEvals++;
+    }
+    uint16_t rising = rules & ~ruleTrue;
+    ruleTrue = rules;
+    primed = true;
+
+    uint8_t inhibit = 0;
+    for (uint8_t i = 0; i < table.ruleCount; i++)
+        if ((ruleTrue & (1 << i)) && table.rule[i].action == RULE_INHIBIT)
+            inhibit |= table.rule[i].zones;
+
+    // Cost of the evaluation itself, actions print and switch relays
+    lastUs = micros() - start;
+    if (lastUs > maxUs)
+        maxUs = lastUs;
+    totalUs += lastUs;
+    evaluations++;
+
+    for (uint8_t i = 0; i < table.ruleCount; i++)
+        if (rising & (1 << i))
+            fire(i, inhibit);
+}
+
+// --- CONSOLE ---
+
+static int findName(const char *text, const char *const *names, int count)
+{
+    for (int i = 0; i < count; i++)
+        if (text != NULL && strcasecmp(text, names[i]) == 0)
+            return i;
+    return -1;
+}
+
+// Parses a value in the input's console units into stored units
+static bool parseValue(uint8_t input, const char *text, int16_t *value)
+{
+    char *end = NULL;
+    if (text == NULL)
+        return false;
+
+    if (input == IN_TIME)
+    {
+        unsigned h, m;
+        if (sscanf(text, "%u:%u", &h, &m) != 2 || h > 23 || m > 59)
+            return false;
+        *value = (int16_t)(h * 60 + m);
+        return true;
+    }
+
+    float v = strtof(text, &end);
+    if (end == text)
+        return false;
+    if (input == IN_RAIN_AGE && (*end == 'h' || *end == 'H'))
+    {
+        v *= 60.0f;
+        end++;
+    }
+    if (*end != '\0')
+        return false;
+    v *= inputDefs[input].scale;
+    if (v < INT16_MIN || v > INT16_MAX)
+        return false;
+    *value = (int16_t)lroundf(v);
+    return true;
+}
+
+// "<input> <op> <value>", e.g. "hum < 40" or "rain_age < 6h"
+static void cmdCond(char *args)
+{
+    char *save = NULL;
+    char *inputText = strtok_r(args, " ", &save);
+    char *opText = strtok_r(NULL, " ", &save);
+    char *valueText = strtok_r(NULL, " ", &save);
+    const char *names[IN_COUNT];
+    for (int i = 0; i < IN_COUNT; i++)
+        names[i] = inputDefs[i].name;
+
+    int input = findName(inputText, names, IN_COUNT);
+    int op = findName(opText, opNames, CMP_NE + 1);
+    int16_t value;
+    if (input < 0 || op < 0 || !parseValue(input, valueText, &value))
+    {
+        Serial.println("Usage: rules cond <temp|hum|pressure|lux|rain|rain_age|time> <op> <value>");
+        return;
+    }
+    if (table.condCount >= RULE_MAX_CONDS)
+    {
+        Serial.println("Condition table full");
+        return;
+    }
+    rule_table_t t = table;
+    rule_cond_t *c = &t.cond[t.condCount++];
+    c->input = input;
+    c->op = op;
+    c->value = value;
+    install(&t);
+    saveTable();
+    Serial.printf("Condition %u added\n", table.condCount - 1);
+}
+
+// "<run|inhibit|stop> <c+c+...> <zone digits> [seconds] [cooldown min]"
+static void cmdAdd(char *args)
+{
+    char *save = NULL;
+    char *actionText = strtok_r(args, " ", &save);
+    char *condText = strtok_r(NULL, " ", &save);
+    char *zoneText = strtok_r(NULL, " ", &save);
+    char *argText = strtok_r(NULL, " ", &save);
+    char *coolText = strtok_r(NULL, " ", &save);
+
+    rule_t r;
+    memset(&r, 0, sizeof(r));
+    int action = findName(actionText, actionNames, RULE_STOP + 1);
+    for (const char *p = condText; p != NULL && *p != '\0';)
+    {
+        char *end = NULL;
+        unsigned long c = strtoul(p, &end, 10);
+        if (end == p || c >= table.condCount)
+        {
+            action = -1;
+            break;
+        }
+        r.conds |= 1 << c;
+        p = (*end == '+') ? end + 1 : end;
+        if (*end != '+' && *end != '\0')
+            action = -1;
+    }
+    for (const char *p = zoneText; p != NULL && *p != '\0'; p++)
+        if (*p >= '1' && *p <= '8')
+            r.zones |= 1 << (*p - '1');
+        else
+            action = -1;
+
+    if (action < 0 || condText == NULL || zoneText == NULL)
+    {
+        Serial.println("Usage: rules add <run|inhibit|stop> <cond+cond+...> <zone digits> [seconds] [cooldown min]");
+        return;
+    }
+    r.action = action;
+    r.arg = argText ? (uint16_t)strtoul(argText, NULL, 10) : 0;
+    r.cooldownMin = coolText ? (uint16_t)strtoul(coolText, NULL, 10) : 0;
+
+    rule_table_t t = table;
+    if (t.ruleCount >= RULE_MAX_RULES)
+    {
+        Serial.println("Rule table full");
+        return;
+    }
+    t.rule[t.ruleCount++] = r;
+    if (!tableValid(&t))
+    {
+        Serial.printf("Invalid rule (zones, or run without seconds or over %u s)\n",
+                      (unsigned)(RELAY_MAX_RUNTIME_MS / 1000UL));
+        return;
+    }
+    install(&t);
+    saveTable();
+    Serial.printf("Rule %u added\n", table.ruleCount - 1);
+}
+
+void rulesCommand(char *args)
+{
+    while (*args == ' ')
+        args++;
+    char *rest = strchr(args, ' ');
+    if (rest != NULL)
+        *rest++ = '\0';
+    else
+        rest = args + strlen(args);
+
+    if (*args == '\0')
+    {
+        rulesPrint(Serial);
+        return;
+    }
+    else if (strcasecmp(args, "on") == 0 || strcasecmp(args, "off") == 0)
+    {
+        table.enabled = strcasecmp(args, "on") == 0;
+        // Start from scratch so rules already true fire on the next sample
+        condTrue = 0;
+        ruleTrue = 0;
+        primed = false;
+        saveTable();
+    }
+    else if (strcasecmp(args, "clear") == 0)
+    {
+        rule_table_t t;
+        memset(&t, 0, sizeof(t));
+        t.version = RULE_TABLE_VERSION;
+        t.enabled = table.enabled;
+        install(&t);
+        saveTable();
+    }
+    else if (strcasecmp(args, "default") == 0)
+    {
+        rule_table_t t = defaultTable;
+        t.enabled = table.enabled;
+        install(&t);
+        saveTable();
+    }
+    else if (strcasecmp(args, "cond") == 0)
+    {
+        cmdCond(rest);
+        return;
+    }
+    else if (strcasecmp(args, "add") == 0)
+    {
+        cmdAdd(rest);
+        return;
+    }
+    else
+    {
+        Serial.println("Usage: rules [on|off|clear|default|cond ...|add ...]");
+        return;
+    }
+    rulesPrint(Serial);
+}
+
+static void printValue(Print &out, uint8_t input, int16_t value)
+{
+    if (input == IN_TIME)
+        out.printf("%02d:%02d", value / 60, value % 60);
+    else if (inputDefs[input].scale != 1.0f)
+        out.printf("%.2f", value / inputDefs[input].scale);
+    else
+        out.printf("%d", value);
+}
+
+void rulesPrint(Print &out)
+{
+    uint32_t now = millis();
+    int minute = rulesClock();
+
+    out.printf("Rules: %s, table %u bytes, clock ", table.enabled ? "enabled" : "disabled",
+               (unsigned)RULE_BLOB_LEN(table.condCount, table.ruleCount));
+    if (minute < 0)
+        out.println("not set");
+    else
+        out.printf("%02d:%02d\n", minute / 60, minute % 60);
+
+    for (uint8_t i = 0; i < table.condCount; i++)
+    {
+        const rule_cond_t *c = &table.cond[i];
+        out.printf("  c%-2u %s %s %s ", i, (condTrue & (1 << i)) ? "T" : "-",
+                   inputDefs[c->input].name, opNames[c->op]);
+        printValue(out, c->input, c->value);
+        out.print("  (now ");
+        if (inputValid & (1 << c->input))
+            printValue(out, c->input, inputs[c->input]);
+        else
+            out.print("n/a");
+        out.println(")");
+    }
+    for (uint8_t i = 0; i < table.ruleCount; i++)
+    {
+        const rule_t *r = &table.rule[i];
+        out.printf("  r%-2u %s %-7s conds 0x%04X zones 0x%02X", i, (ruleTrue & (1 << i)) ? "T" : "-",
+                   actionNames[r->action], r->conds, r->zones);
+        if (r->action == RULE_RUN)
+            out.printf(" %u s", r->arg);
+        if (r->cooldownMin)
+            out.printf(", cooldown %u min", r->cooldownMin);
+        if (hasFired & (1 << i))
+            out.printf(", fired %u min ago", (unsigned)((now - lastFiredMs[i]) / 60000UL));
+        out.println();
+    }
+
+    out.printf("  samples %u, evaluated %u, cond evals %u, rule evals %u\n",
+               (unsigned)samples, (unsigned)evaluations, (unsigned)condEvals, (unsigned)ruleEvals);
+    out.printf("  eval cost last %u us, max %u us, avg %.1f us\n", (unsigned)lastUs, (unsigned)maxUs,
+               evaluations ? (float)totalUs / evaluations : 0.0f);
+    out.printf("  fired %u, suppressed %u\n", (unsigned)fires, (unsigned)suppressed);
+}
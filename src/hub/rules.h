@@ -0,0 +1,83 @@
+// File: src/hub/rules.h
+// Local irrigation rules, evaluated on the hub from each sensor sample.
+// A rule table is a list of conditions (input <op> constant) and a list
+// of rules that AND a set of conditions together. Conditions are only
+// recomputed when their input changed, and rules only when one of their
+// conditions flipped. The table is small and fixed-size, so one
+// evaluation is bounded by RULE_MAX_CONDS compares and RULE_MAX_RULES
+// mask tests.
+#pragma once
+
+#include <Arduino.h>
+#include "protocol.h"
+
+#define RULE_MAX_CONDS 16
+#define RULE_MAX_RULES 16
+#define RULE_TABLE_VERSION 1
+
+// --- RULE INPUTS ---
+#define IN_TEMP 0     // 0.01 degC
+#define IN_HUMIDITY 1 // 0.01 %RH
+#define IN_PRESSURE 2 // 10 Pa (0.1 hPa)
+#define IN_LUX 3      // lux, capped at 32767
+#define IN_RAIN 4     // 1 = wet now
+#define IN_RAIN_AGE 5 // minutes since the sensor was last wet
+#define IN_TIME 6     // minute of the day, valid once the clock is set
+#define IN_COUNT 7
+
+// --- CONDITION OPERATORS ---
+#define CMP_LT 0
+#define CMP_LE 1
+#define CMP_GT 2
+#define CMP_GE 3
+#define CMP_EQ 4
+#define CMP_NE 5
+
+// --- RULE ACTIONS ---
+#define RULE_RUN 0     // on becoming true: run zones for arg seconds
+#define RULE_INHIBIT 1 // while true: RUN rules may not start these zones
+#define RULE_STOP 2    // on becoming true: close these zones
+
+// A condition on an input that is not valid (sensor missing, clock
+// not set) is false.
+typedef struct __attribute__((packed)) rule_cond_t
+{
+    uint8_t input;
+    uint8_t op;
+    int16_t value;
+} rule_cond_t;
+
+typedef struct __attribute__((packed)) rule_t
+{
+    uint16_t conds; // bit per condition, all must be true
+    uint8_t action;
+    uint8_t zones;        // zone mask
+    uint16_t arg;         // RUN: seconds
+    uint16_t cooldownMin; // RUN/STOP: minimum time between firings
+} rule_t;
+
+// Stored in NVS as the header plus only the used entries
+typedef struct __attribute__((packed)) rule_table_t
+{
+    uint8_t version;
+    uint8_t condCount;
+    uint8_t ruleCount;
+    uint8_t enabled;
+    rule_cond_t cond[RULE_MAX_CONDS];
+    rule_t rule[RULE_MAX_RULES];
+} rule_table_t;
+
+// Loads the table from NVS, or the built-in default
+void rulesBegin();
+
+// Feeds one sample; re-evaluates whatever it changed
+void rulesOnSample(const sensor_sample_t *sample);
+
+// Minute of the day, there is no RTC on the hub. -1 = unknown.
+void rulesSetClock(int minuteOfDay);
+int rulesClock();
+
+// Console front end: "rules [on|off|clear|default|cond ...|add ...]"
+void rulesCommand(char *args);
+
+void rulesPrint(Print &out);
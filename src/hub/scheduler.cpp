@@ -0,0 +1,44 @@
+// File: src/hub/scheduler.cpp
+#include "scheduler.h"
+
+uint32_t schedulerRun(sched_job_t *jobs, size_t count)
+{
+    uint32_t nextDue = UINT32_MAX;
+
+    for (size_t i = 0; i < count; i++)
+    {
+        sched_job_t *job = &jobs[i];
+        uint32_t now = millis();
+        uint32_t elapsed = now - job->lastMs;
+
+        if (elapsed >= job->intervalMs)
+        {
+            uint32_t start = micros();
+            job->fn();
+            uint32_t took = micros() - start;
+
+            job->runs++;
+            if (took > job->maxUs)
+                job->maxUs = took;
+
+            // Stay on the original grid unless we fell a whole period behind
+            job->lastMs = (elapsed >= 2 * job->intervalMs) ? now : job->lastMs + job->intervalMs;
+            elapsed = millis() - job->lastMs;
+        }
+
+        uint32_t wait = (elapsed >= job->intervalMs) ? 0 : job->intervalMs - elapsed;
+        if (wait < nextDue)
+            nextDue = wait;
+    }
+    return nextDue;
+}
+
+void schedulerPrintStats(Print &out, const sched_job_t *jobs, size_t count)
+{
+    out.println("Jobs:");
+    for (size_t i = 0; i < count; i++)
+    {
+        out.printf("  %-10s every %5u ms, %8u runs, max %6u us\n", jobs[i].name,
+                   (unsigned)jobs[i].intervalMs, (unsigned)jobs[i].runs, (unsigned)jobs[i].maxUs);
+    }
+}
@@ -0,0 +1,23 @@
+// File: src/hub/scheduler.h
+// Cooperative scheduler for loop(): periodic jobs instead of delay().
+// Jobs must return quickly; anything slow belongs in its own task.
+#pragma once
+
+#include <Arduino.h>
+
+typedef void (*job_fn_t)(void);
+
+typedef struct sched_job_t
+{
+    const char *name;
+    uint32_t intervalMs;
+    job_fn_t fn;
+    uint32_t lastMs;
+    uint32_t runs;
+    uint32_t maxUs; // longest single run, to spot jobs that block
+} sched_job_t;
+
+// Runs every job that is due. Returns ms until the next one is due.
+uint32_t schedulerRun(sched_job_t *jobs, size_t count);
+
+void schedulerPrintStats(Print &out, const sched_job_t *jobs, size_t count);
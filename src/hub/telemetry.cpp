@@ -0,0 +1,132 @@
+// File: src/hub/telemetry.cpp
+#include "telemetry.h"
+#include <esp_now.h>
+#include <Preferences.h>
+#include "relay.h"
+
+static const uint8_t broadcastMac[6] = {0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF};
+
+static telemetry_message frame;
+static bool haveSample = false;
+static uint32_t intervalMs = TELEMETRY_DEFAULT_INTERVAL_MS;
+static uint32_t lastSendMs = 0;
+
+// Set from the command task, consumed by loop()
+static volatile bool changePending = false;
+
+// Token bucket
+static uint32_t tokens = TELEMETRY_BURST;
+static uint32_t lastRefillMs = 0;
+static bool throttledPending = false; // the waiting frame was counted
+
+static uint32_t sentCount = 0;
+static uint32_t throttledCount = 0;
+static uint32_t failedCount = 0;
+
+void telemetryBegin()
+{
+    Preferences prefs;
+    if (prefs.begin("hub", true))
+    {
+        intervalMs = prefs.getUInt("tlm_ms", TELEMETRY_DEFAULT_INTERVAL_MS);
+        prefs.end();
+    }
+
+    esp_now_peer_info_t peerInfo;
+    memset(&peerInfo, 0, sizeof(peerInfo));
+    memcpy(peerInfo.peer_addr, broadcastMac, 6);
+    peerInfo.channel = 0;
+    peerInfo.encrypt = false; // ESP-NOW cannot encrypt broadcasts
+    if (!esp_now_is_peer_exist(broadcastMac) && esp_now_add_peer(&peerInfo) != ESP_OK)
+        Serial.println("Warning: telemetry broadcast peer not added");
+
+    memset(&frame, 0, sizeof(frame));
+    frame.hdr.type = MSG_TELEMETRY;
+    frame.hdr.version = PROTOCOL_VERSION;
+    do
+    {
+        frame.hdr.session = esp_random();
+    } while (frame.hdr.session == 0);
+
+    lastRefillMs = millis();
+}
+
+void telemetrySetInterval(uint32_t ms)
+{
+    if (ms != 0 && ms < TELEMETRY_MIN_INTERVAL_MS)
+        ms = TELEMETRY_MIN_INTERVAL_MS;
+    intervalMs = ms;
+
+    Preferences prefs;
+    prefs.begin("hub", false);
+    prefs.putUInt("tlm_ms", ms);
+    prefs.end();
+}
+
+uint32_t telemetryInterval()
+{
+    return intervalMs;
+}
+
+void telemetryOffer(const sensor_sample_t *sample)
+{
+    frame.sample = *sample;
+    haveSample = true;
+}
+
+void telemetryNotifyChange()
+{
+    changePending = true;
+}
+
+static void refill(uint32_t now)
+{
+    uint32_t earned = (now - lastRefillMs) / TELEMETRY_MIN_INTERVAL_MS;
+    if (earned == 0)
+        return;
+    tokens = min(tokens + earned, (uint32_t)TELEMETRY_BURST);
+    lastRefillMs += earned * TELEMETRY_MIN_INTERVAL_MS;
+}
+
+void telemetryPoll()
+{
+    if (!haveSample)
+        return;
+
+    uint32_t now = millis();
+    bool periodic = intervalMs != 0 && now - lastSendMs >= intervalMs;
+    if (!periodic && !changePending)
+        return;
+
+    refill(now);
+    if (tokens == 0)
+    {
+        // Counted once per held-back frame, not on every poll it waits
+        if (!throttledPending)
+            throttledCount++;
+        throttledPending = true;
+        return; // retried on the next poll once a token is earned
+    }
+    tokens--;
+    throttledPending = false;
+
+    changePending = false;
+    frame.sample.relayOn = relayOpenMask();
+    frame.hdr.seq++;
+    lastSendMs = now;
+
+    if (esp_now_send(broadcastMac, (uint8_t *)&frame, sizeof(frame)) == ESP_OK)
+        sentCount++;
+    else
+        failedCount++;
+}
+
+void telemetryPrintStats(Print &out)
+{
+    if (intervalMs == 0)
+        out.print("Telemetry: periodic off");
+    else
+        out.printf("Telemetry: every %u ms", (unsigned)intervalMs);
+    out.printf(", %u sent, %u throttled, %u failed\n",
+               (unsigned)sentCount, (unsigned)throttledCount, (unsigned)failedCount);
+}
@@ -0,0 +1,29 @@
+// File: src/hub/telemetry.h
+// Broadcasts the latest sensor sample to every listening remote.
+// One broadcast frame serves any number of remotes. A token bucket caps
+// the sustained rate, so relay-change updates cannot flood the channel.
+#pragma once
+
+#include <Arduino.h>
+#include "protocol.h"
+
+#define TELEMETRY_DEFAULT_INTERVAL_MS 5000
+#define TELEMETRY_MIN_INTERVAL_MS 250 // one token per this period
+#define TELEMETRY_BURST 3             // bucket depth
+
+void telemetryBegin();
+
+// Periodic rate, persisted in NVS. 0 switches periodic broadcasts off.
+void telemetrySetInterval(uint32_t ms);
+uint32_t telemetryInterval();
+
+// Latest sample from the sensor loop
+void telemetryOffer(const sensor_sample_t *sample);
+
+// Pump state changed: broadcast as soon as a token is available
+void telemetryNotifyChange();
+
+// Called from loop(), sends when due
+void telemetryPoll();
+
+void telemetryPrintStats(Print &out);
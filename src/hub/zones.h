@@ -0,0 +1,52 @@
+// File: src/hub/zones.h
+// Compile-time zone table for the hub relay bank.
+// Zones are addressed by bitmask: bit 0 = ZONES[0], bit 1 = ZONES[1], ...
+// Every zone pin must be GPIO 0..31 so the whole bank can be switched
+// with one write to the GPIO set/clear registers.
+#pragma once
+
+#include <stdint.h>
+
+typedef struct zone_def_t
+{
+    const char *name; // matches the screen's roller entries
+    uint8_t pin;
+} zone_def_t;
+
+// --- ZONE TABLE ---
+static constexpr zone_def_t ZONES[] = {
+    {"Zone 1", 4}, // the original PIN_PUMP_RELAY
+    {"Zone 2", 5},
+};
+
+#define ZONE_ACTIVE_LOW true // relay board inputs are active LOW
+#define ZONE_MAX_OPEN 1      // interlock: zones allowed open at once (water pressure)
+#define ZONE_DEFAULT_MASK 0x01 // used when a command has no target
+
+static constexpr uint8_t ZONE_COUNT = sizeof(ZONES) / sizeof(ZONES[0]);
+static constexpr uint8_t ZONE_ALL_MASK = (uint8_t)((1u << ZONE_COUNT) - 1);
+
+// GPIO register bits for a zone mask
+static constexpr uint32_t zonePinMask(uint8_t zones, uint8_t i = 0)
+{
+    return i >= ZONE_COUNT ? 0
+                           : (((zones >> i) & 1) ? (1UL << ZONES[i].pin) : 0) | zonePinMask(zones, i + 1);
+}
+
+static constexpr bool zonePinsValid(uint8_t i = 0)
+{
+    return i >= ZONE_COUNT || (ZONES[i].pin < 32 && zonePinsValid(i + 1));
+}
+
+static constexpr bool zonePinsUnique(uint8_t i = 0, uint32_t seen = 0)
+{
+    return i >= ZONE_COUNT || (!(seen & (1UL << ZONES[i].pin)) && zonePinsUnique(i + 1, seen | (1UL << ZONES[i].pin)));
+}
+
+static_assert(ZONE_COUNT >= 1 && ZONE_COUNT <= 8, "zones are addressed by an 8-bit mask");
+static_assert(zonePinsValid(), "zone pins must be GPIO 0..31 (single GPIO_OUT register)");
+static_assert(zonePinsUnique(), "two zones share a pin");
+static_assert(ZONE_MAX_OPEN >= 1 && ZONE_MAX_OPEN <= ZONE_COUNT, "bad ZONE_MAX_OPEN");
+static_assert((ZONE_DEFAULT_MASK & ~ZONE_ALL_MASK) == 0, "ZONE_DEFAULT_MASK names a missing zone");
+
+static constexpr uint32_t ZONE_PIN_MASK = zonePinMask(ZONE_ALL_MASK);
@@ -0,0 +1,442 @@
+// File: src/remote/bench.cpp
+#include "bench.h"
+#include <esp_now.h>
+#include "protocol.h"
+#include "remote.h"
+#include "send_queue.h"
+
+#define BENCH_QUEUE_DEPTH 32
+#define BENCH_TIMEOUT_MS 100 // a ping without reply by then counts as lost
+#define BENCH_DRAIN_MS 500   // wait for stragglers after the rate pass
+#define BENCH_SEND_RETRIES 50
+
+// Latency histogram: 10 us steps up to 2 ms, then 100 us steps up to 50 ms
+#define HIST_FINE_US 10
+#define HIST_FINE_BUCKETS 200
+#define HIST_COARSE_US 100
+#define HIST_COARSE_BUCKETS 480
+#define HIST_BUCKETS (HIST_FINE_BUCKETS + HIST_COARSE_BUCKETS)
+
+typedef struct rx_pong_t
+{
+    bench_message msg;
+    uint32_t rxMicros;
+} rx_pong_t;
+
+typedef struct bench_result_t
+{
+    uint32_t sent;
+    uint32_t received;
+    uint32_t minUs;
+    uint32_t maxUs;
+    uint64_t sumUs;
+    uint32_t elapsedUs;
+} bench_result_t;
+
+typedef struct latency_hist_t
+{
+    uint32_t bucket[HIST_BUCKETS];
+    uint32_t count;
+    uint32_t overflow; // beyond the last bucket
+    uint32_t maxUs;
+    uint64_t sumUs;
+} latency_hist_t;
+
+static StaticQueue_t pongQueueBuffer;
+static uint8_t pongQueueStorage[BENCH_QUEUE_DEPTH * sizeof(rx_pong_t)];
+static QueueHandle_t pongQueue = NULL;
+static volatile bool benchRunning = false;
+
+// Too big for the loop task's stack
+static latency_hist_t rttHist;
+static latency_hist_t pinHist;
+static latency_hist_t hubHist;
+
+// Edges on the sense pin, from the ISR
+static volatile uint32_t edgeMicros = 0;
+static volatile uint32_t edgeCount = 0;
+
+void benchBegin()
+{
+    pongQueue = xQueueCreateStatic(BENCH_QUEUE_DEPTH, sizeof(rx_pong_t), pongQueueStorage, &pongQueueBuffer);
+}
+
+void benchOnPong(const uint8_t *data, uint32_t rxMicros)
+{
+    if (!benchRunning)
+        return;
+
+    rx_pong_t item;
+    memcpy(&item.msg, data, sizeof(bench_message));
+    item.rxMicros = rxMicros;
+    xQueueSend(pongQueue, &item, 0);
+}
+
+static bool sendPing(uint32_t seq, uint8_t flags, uint32_t *sentAt = NULL)
+{
+    bench_message ping;
+    memset(&ping, 0, sizeof(ping));
+    ping.hdr.type = MSG_BENCH_PING;
+    ping.hdr.version = PROTOCOL_VERSION;
+    ping.hdr.session = txSession;
+    ping.hdr.seq = seq;
+    ping.flags = flags;
+
+    // ESP-NOW's TX buffer fills up when sending back to back: back off briefly
+    for (int i = 0; i < BENCH_SEND_RETRIES; i++)
+    {
+        ping.sentMicros = micros();
+        esp_err_t err = sendQueueSendDirect(hubMacAddress, (uint8_t *)&ping, sizeof(ping));
+        if (err == ESP_OK)
+        {
+            if (sentAt != NULL)
+                *sentAt = ping.sentMicros;
+            return true;
+        }
+        if (err != ESP_ERR_ESPNOW_NO_MEM)
+            return false;
+        vTaskDelay(1);
+    }
+    return false;
+}
+
+static void resetResult(bench_result_t *r)
+{
+    memset(r, 0, sizeof(*r));
+    r->minUs = UINT32_MAX;
+}
+
+static void record(bench_result_t *r, const rx_pong_t *p)
+{
+    uint32_t rtt = p->rxMicros - p->msg.sentMicros;
+    r->received++;
+    r->sumUs += rtt;
+    if (rtt < r->minUs)
+        r->minUs = rtt;
+    if (rtt > r->maxUs)
+        r->maxUs = rtt;
+}
+
+static void drainPongs()
+{
+    rx_pong_t p;
+    while (xQueueReceive(pongQueue, &p, 0) == pdTRUE)
+    {
+    }
+}
+
+// One ping in flight at a time: pure round-trip latency
+static void latencyPass(uint32_t count, uint8_t flags, bench_result_t *r)
+{
+    resetResult(r);
+    drainPongs();
+    uint32_t start = micros();
+
+    for (uint32_t seq = 1; seq <= count; seq++)
+    {
+        if (!sendPing(seq, flags))
+            continue;
+        r->sent++;
+
+        // Late replies to earlier pings are skipped
+        rx_pong_t p;
+        TickType_t deadline = xTaskGetTickCount() + pdMS_TO_TICKS(BENCH_TIMEOUT_MS);
+        int32_t remaining;
+        while ((remaining = (int32_t)(deadline - xTaskGetTickCount())) > 0 &&
+               xQueueReceive(pongQueue, &p, remaining) == pdTRUE)
+        {
+            if (p.msg.hdr.seq == seq)
+            {
+                record(r, &p);
+                break;
+            }
+        }
+    }
+
+    r->elapsedUs = micros() - start;
+}
+
+// Pings back to back, limited only by the radio: maximum command rate
+static void ratePass(uint32_t count, uint8_t flags, bench_result_t *r)
+{
+    resetResult(r);
+    drainPongs();
+    uint32_t start = micros();
+    uint32_t lastRx = start;
+    rx_pong_t p;
+
+    for (uint32_t seq = 1; seq <= count; seq++)
+    {
+        if (sendPing(seq, flags))
+            r->sent++;
+        while (xQueueReceive(pongQueue, &p, 0) == pdTRUE)
+        {
+            record(r, &p);
+            lastRx = p.rxMicros;
+        }
+    }
+    while (xQueueReceive(pongQueue, &p, pdMS_TO_TICKS(BENCH_DRAIN_MS)) == pdTRUE)
+    {
+        record(r, &p);
+        lastRx = p.rxMicros;
+    }
+
+    r->elapsedUs = lastRx - start;
+}
+
+static void printResult(const char *label, const bench_result_t *lat, const bench_result_t *rate)
+{
+    Serial.printf("[%s]\n", label);
+    if (lat->received == 0)
+    {
+        Serial.printf("  latency: no replies (%u sent)\n", (unsigned)lat->sent);
+    }
+    else
+    {
+        Serial.printf("  latency: min %.2f / avg %.2f / max %.2f ms, loss %u/%u\n",
+                      lat->minUs / 1000.0f, (float)(lat->sumUs / lat->received) / 1000.0f, lat->maxUs / 1000.0f,
+                      (unsigned)(lat->sent - lat->received), (unsigned)lat->sent);
+    }
+    if (rate->elapsedUs > 0 && rate->received > 0)
+    {
+        Serial.printf("  rate:    %.1f cmd/s (%u/%u replies in %.1f ms)\n",
+                      rate->received * 1e6f / rate->elapsedUs,
+                      (unsigned)rate->received, (unsigned)rate->sent, rate->elapsedUs / 1000.0f);
+    }
+}
+
+void benchRun(uint32_t count)
+{
+    bench_result_t lat, rate, encLat, encRate;
+    bool encrypted = hubKeyInstalled();
+
+    Serial.printf("Benchmark: %u pings per pass\n", (unsigned)count);
+    benchRunning = true;
+
+    if (encrypted)
+    {
+        setHubEncryption(true);
+        latencyPass(count, BENCH_FLAG_ENCRYPTED, &encLat);
+        ratePass(count, BENCH_FLAG_ENCRYPTED, &encRate);
+
+        // Ask the Hub, still encrypted, to answer in plain for the next pass
+        drainPongs();
+        sendPing(++txSeq, BENCH_FLAG_ENCRYPTED | BENCH_FLAG_SWITCH_PLAIN); // deduped like a command
+        rx_pong_t p;
+        xQueueReceive(pongQueue, &p, pdMS_TO_TICKS(BENCH_TIMEOUT_MS));
+        setHubEncryption(false);
+    }
+
+    latencyPass(count, 0, &lat);
+    ratePass(count, 0, &rate);
+
+    if (encrypted)
+    {
+        // Tell the Hub the plain pass is over, or it refuses our commands
+        // until it notices the pings have stopped
+        drainPongs();
+        sendPing(++txSeq, BENCH_FLAG_END_PLAIN);
+        rx_pong_t p;
+        xQueueReceive(pongQueue, &p, pdMS_TO_TICKS(BENCH_TIMEOUT_MS));
+    }
+
+    benchRunning = false;
+    setHubEncryption(encrypted);
+
+    printResult("plain", &lat, &rate);
+    if (encrypted)
+    {
+        printResult("encrypted", &encLat, &encRate);
+        if (lat.received > 0 && encLat.received > 0)
+        {
+            float plainAvg = (float)(lat.sumUs / lat.received);
+            float encAvg = (float)(encLat.sumUs / encLat.received);
+            Serial.printf("  encryption adds %.1f us per round trip\n", encAvg - plainAvg);
+        }
+    }
+    else
+    {
+        Serial.println("No LMK provisioned ('key lmk <hex>'), encrypted pass skipped");
+    }
+}
+
+static void histReset(latency_hist_t *h)
+{
+    memset(h, 0, sizeof(*h));
+}
+
+static void histAdd(latency_hist_t *h, uint32_t us)
+{
+    h->count++;
+    h->sumUs += us;
+    if (us > h->maxUs)
+        h->maxUs = us;
+
+    uint32_t i;
+    if (us < HIST_FINE_BUCKETS * HIST_FINE_US)
+        i = us / HIST_FINE_US;
+    else
+        i = HIST_FINE_BUCKETS + (us - HIST_FINE_BUCKETS * HIST_FINE_US) / HIST_COARSE_US;
+    if (i < HIST_BUCKETS)
+        h->bucket[i]++;
+    else
+        h->overflow++;
+}
+
+// Upper edge of the bucket holding the p-th percentile, never above max
+static uint32_t histPercentile(const latency_hist_t *h, uint32_t p)
+{
+    uint32_t target = (uint32_t)(((uint64_t)h->count * p + 99) / 100);
+    uint32_t seen = 0;
+    for (uint32_t i = 0; i < HIST_BUCKETS; i++)
+    {
+        seen += h->bucket[i];
+        if (seen >= target)
+        {
+            uint32_t upper = i < HIST_FINE_BUCKETS
+                                 ? (i + 1) * HIST_FINE_US
+                                 : HIST_FINE_BUCKETS * HIST_FINE_US + (i - HIST_FINE_BUCKETS + 1) * HIST_COARSE_US;
+            return min(upper, h->maxUs);
+        }
+    }
+    return h->maxUs;
+}
+
+static void histPrint(const char *label, const latency_hist_t *h)
+{
+    if (h->count == 0)
+    {
+        Serial.printf("  %s: no samples\n", label);
+        return;
+    }
+    Serial.printf("  %s: p50 %.2f / p90 %.2f / p99 %.2f / max %.2f ms, avg %.2f ms\n", label,
+                  histPercentile(h, 50) / 1000.0f, histPercentile(h, 90) / 1000.0f,
+                  histPercentile(h, 99) / 1000.0f, h->maxUs / 1000.0f,
+                  (float)(h->sumUs / h->count) / 1000.0f);
+}
+
+static void IRAM_ATTR onSenseEdge()
+{
+    edgeMicros = micros();
+    edgeCount++;
+}
+
+// Paced stream of pings, replies collected as they come
+static void pingPass(uint32_t count, uint32_t rate, uint32_t *sent, uint32_t *elapsedUs)
+{
+    uint32_t periodUs = rate > 0 ? 1000000UL / rate : 0;
+    uint32_t start = micros();
+    uint32_t next = start;
+    uint32_t lastRx = start;
+    rx_pong_t p;
+
+    for (uint32_t seq = 1; seq <= count; seq++)
+    {
+        // Collect replies while waiting for the next slot
+        do
+        {
+            while (xQueueReceive(pongQueue, &p, 0) == pdTRUE)
+            {
+                histAdd(&rttHist, p.rxMicros - p.msg.sentMicros);
+                lastRx = p.rxMicros;
+            }
+            if ((int32_t)(next - micros()) > 2000)
+                vTaskDelay(1);
+        } while ((int32_t)(next - micros()) > 0);
+        next += periodUs;
+
+        if (sendPing(seq, 0))
+            (*sent)++;
+    }
+    while (xQueueReceive(pongQueue, &p, pdMS_TO_TICKS(BENCH_DRAIN_MS)) == pdTRUE)
+    {
+        histAdd(&rttHist, p.rxMicros - p.msg.sentMicros);
+        lastRx = p.rxMicros;
+    }
+    *elapsedUs = lastRx - start;
+}
+
+// One ping at a time, each waits for its pin edge and its reply
+static void gpioPass(uint32_t count, uint32_t rate, uint32_t *sent, uint32_t *elapsedUs)
+{
+    uint32_t periodUs = rate > 0 ? 1000000UL / rate : 0;
+    pinMode(BENCH_SENSE_PIN, INPUT);
+    attachInterrupt(digitalPinToInterrupt(BENCH_SENSE_PIN), onSenseEdge, CHANGE);
+    uint32_t start = micros();
+
+    for (uint32_t i = 0; i < count; i++)
+    {
+        uint32_t slot = micros();
+        uint32_t edgesBefore = edgeCount;
+        uint32_t sentAt;
+        uint32_t seq = ++txSeq; // the Hub dedups GPIO pings like commands
+        if (!sendPing(seq, BENCH_FLAG_GPIO, &sentAt))
+            continue;
+        (*sent)++;
+
+        // Block on the reply; the edge comes first (the Hub writes the pin
+        // before it answers), so it is normally there by then
+        bool pong = false;
+        rx_pong_t p;
+        TickType_t deadline = xTaskGetTickCount() + pdMS_TO_TICKS(BENCH_TIMEOUT_MS);
+        int32_t remaining;
+        while (!pong && (remaining = (int32_t)(deadline - xTaskGetTickCount())) > 0 &&
+               xQueueReceive(pongQueue, &p, remaining) == pdTRUE)
+        {
+            if (p.msg.hdr.seq != seq)
+                continue;
+            histAdd(&rttHist, p.rxMicros - p.msg.sentMicros);
+            histAdd(&hubHist, p.msg.hubUs);
+            pong = true;
+        }
+        while (edgeCount == edgesBefore && (int32_t)(deadline - xTaskGetTickCount()) > 0)
+            vTaskDelay(1);
+        if (edgeCount != edgesBefore)
+            histAdd(&pinHist, edgeMicros - sentAt);
+
+        while ((int32_t)(slot + periodUs - micros()) > 0)
+            vTaskDelay(1);
+    }
+
+    detachInterrupt(digitalPinToInterrupt(BENCH_SENSE_PIN));
+    *elapsedUs = micros() - start;
+}
+
+void benchLatency(uint32_t count, uint32_t rate, bool gpio)
+{
+    histReset(&rttHist);
+    histReset(&pinHist);
+    histReset(&hubHist);
+    drainPongs();
+
+    if (rate > 0)
+        Serial.printf("Latency benchmark: %u %s pings at %u/s\n", (unsigned)count, gpio ? "GPIO" : "echo",
+                      (unsigned)rate);
+    else
+        Serial.printf("Latency benchmark: %u %s pings, unpaced\n", (unsigned)count, gpio ? "GPIO" : "echo");
+
+    uint32_t sent = 0;
+    uint32_t elapsedUs = 0;
+    benchRunning = true;
+    if (gpio)
+        gpioPass(count, rate, &sent, &elapsedUs);
+    else
+        pingPass(count, rate, &sent, &elapsedUs);
+    benchRunning = false;
+
+    uint32_t received = rttHist.count;
+    Serial.printf("  %u/%u replies (loss %.2f %%) in %.2f s, %.1f replies/s\n", (unsigned)received,
+                  (unsigned)sent, sent ? (sent - received) * 100.0f / sent : 0.0f, elapsedUs / 1e6f,
+                  elapsedUs ? received * 1e6f / elapsedUs : 0.0f);
+    histPrint("round trip", &rttHist);
+    if (gpio)
+    {
+        histPrint("send to pin edge", &pinHist);
+        histPrint("hub receive to pin", &hubHist);
+        if (pinHist.count == 0)
+            Serial.printf("  No edges on GPIO%u: is the Hub's probe pin wired to it?\n", BENCH_SENSE_PIN);
+    }
+    if (rttHist.overflow > 0)
+        Serial.printf("  %u samples above %u ms\n", (unsigned)rttHist.overflow,
+                      (HIST_FINE_BUCKETS * HIST_FINE_US + HIST_COARSE_BUCKETS * HIST_COARSE_US) / 1000);
+}
@@ -0,0 +1,26 @@
+// File: src/remote/bench.h
+// Link benchmark: per-frame round trip and maximum ping rate to the Hub,
+// with and without ESP-NOW encryption. Started with "bench [n]".
+// "bench ping" and "bench gpio" give latency percentiles as a regression
+// baseline; the GPIO variant needs the Hub's probe pin (PIN_BENCH_PROBE)
+// wired to BENCH_SENSE_PIN here, with a common ground.
+#pragma once
+
+#include <Arduino.h>
+
+#define BENCH_DEFAULT_COUNT 200
+#define BENCH_LATENCY_DEFAULT_COUNT 2000
+#define BENCH_SENSE_PIN 34
+
+void benchBegin();
+
+// Called from the receive callback with a MSG_BENCH_PONG frame
+void benchOnPong(const uint8_t *data, uint32_t rxMicros);
+
+// Blocks until all passes are done
+void benchRun(uint32_t count);
+
+// count pings at rate per second (0 = as fast as the radio takes them),
+// then prints throughput and p50/p90/p99/max. gpio: time from send to
+// the edge on BENCH_SENSE_PIN instead, one ping at a time. Blocks.
+void benchLatency(uint32_t count, uint32_t rate, bool gpio);
@@ -0,0 +1,341 @@
+// File: src/remote/macro.cpp
+#include "macro.h"
+#include <Preferences.h>
+#include "protocol.h"
+#include "remote.h"
+#include "op_script.h"
+#include "send_queue.h"
+
+#define NVS_NAMESPACE "macros"
+
+// Stored per slot as "m0".."m7", only count ops of ops[] are written
+typedef struct __attribute__((packed)) macro_rec_t
+{
+    char name[MACRO_NAME_MAX + 1];
+    uint8_t count;
+    batch_op_t ops[BATCH_MAX_OPS];
+} macro_rec_t;
+
+#define MACRO_REC_LEN(n) (offsetof(macro_rec_t, ops) + (n) * sizeof(batch_op_t))
+
+typedef struct macro_player_t
+{
+    bool active;
+    macro_rec_t rec;
+    uint8_t next;
+    uint32_t dueMs;
+    uint32_t awaitSeq; // step waiting for its ACK, 0 = none
+} macro_player_t;
+
+static macro_player_t player;
+
+static void slotKey(uint8_t slot, char *key)
+{
+    snprintf(key, 4, "m%u", slot);
+}
+
+static bool loadSlot(Preferences &prefs, uint8_t slot, macro_rec_t *rec)
+{
+    char key[4];
+    slotKey(slot, key);
+    size_t len = prefs.getBytes(key, rec, sizeof(*rec));
+    return len >= MACRO_REC_LEN(0) && rec->count <= BATCH_MAX_OPS && len == MACRO_REC_LEN(rec->count);
+}
+
+// Slot holding name, or -1. freeSlot gets the first empty one.
+static int findMacro(Preferences &prefs, const char *name, macro_rec_t *rec, int *freeSlot)
+{
+    macro_rec_t tmp;
+    if (freeSlot != NULL)
+        *freeSlot = -1;
+    for (uint8_t i = 0; i < MACRO_SLOTS; i++)
+    {
+        if (!loadSlot(prefs, i, &tmp))
+        {
+            if (freeSlot != NULL && *freeSlot < 0)
+                *freeSlot = i;
+            continue;
+        }
+        if (strcasecmp(tmp.name, name) == 0)
+        {
+            if (rec != NULL)
+                *rec = tmp;
+            return i;
+        }
+    }
+    return -1;
+}
+
+static void printMacro(const macro_rec_t *rec)
+{
+    Serial.printf("%s: %u op(s), %.1f s of waits\n", rec->name, rec->count,
+                  opScriptDurationMs(rec->ops, rec->count) / 1000.0f);
+    for (uint8_t i = 0; i < rec->count; i++)
+    {
+        Serial.printf("  %2u: ", i + 1);
+        printOp(Serial, &rec->ops[i]);
+        Serial.println();
+    }
+}
+
+static void listMacros()
+{
+    Preferences prefs;
+    prefs.begin(NVS_NAMESPACE, true);
+    macro_rec_t rec;
+    int n = 0;
+    for (uint8_t i = 0; i < MACRO_SLOTS; i++)
+    {
+        if (!loadSlot(prefs, i, &rec))
+            continue;
+        Serial.printf("  %-*s %2u op(s), %.1f s\n", MACRO_NAME_MAX, rec.name, rec.count,
+                      opScriptDurationMs(rec.ops, rec.count) / 1000.0f);
+        n++;
+    }
+    prefs.end();
+    Serial.printf("%d/%u macro slots used\n", n, MACRO_SLOTS);
+}
+
+// "add" replaces the macro, "append" extends it (or creates it)
+static void storeMacro(const char *name, const char *script, bool append)
+{
+    if (strlen(name) > MACRO_NAME_MAX)
+    {
+        Serial.printf("Macro names are at most %u characters\n", MACRO_NAME_MAX);
+        return;
+    }
+
+    Preferences prefs;
+    prefs.begin(NVS_NAMESPACE, false);
+    macro_rec_t rec;
+    int freeSlot;
+    int slot = findMacro(prefs, name, &rec, &freeSlot);
+    if (slot < 0 || !append)
+    {
+        memset(&rec, 0, sizeof(rec));
+        strncpy(rec.name, name, MACRO_NAME_MAX);
+    }
+    if (slot < 0)
+        slot = freeSlot;
+    if (slot < 0)
+    {
+        prefs.end();
+        Serial.printf("All %u macro slots are used, 'macro del' one first\n", MACRO_SLOTS);
+        return;
+    }
+
+    const char *error = "";
+    int count = parseOpScript(script, rec.ops + rec.count, BATCH_MAX_OPS - rec.count, &error);
+    if (count < 0)
+    {
+        prefs.end();
+        Serial.printf("Macro error: %s\n", error);
+        return;
+    }
+    rec.count += count;
+
+    char key[4];
+    slotKey(slot, key);
+    prefs.putBytes(key, &rec, MACRO_REC_LEN(rec.count));
+    prefs.end();
+    printMacro(&rec);
+}
+
+static void deleteMacro(const char *name)
+{
+    Preferences prefs;
+    prefs.begin(NVS_NAMESPACE, false);
+    int slot = findMacro(prefs, name, NULL, NULL);
+    if (slot >= 0)
+    {
+        char key[4];
+        slotKey(slot, key);
+        prefs.remove(key);
+        Serial.printf("Macro %s deleted\n", name);
+    }
+    else
+    {
+        Serial.printf("No macro %s\n", name);
+    }
+    prefs.end();
+}
+
+static bool loadMacro(const char *name, macro_rec_t *rec)
+{
+    Preferences prefs;
+    prefs.begin(NVS_NAMESPACE, true);
+    int slot = findMacro(prefs, name, rec, NULL);
+    prefs.end();
+    if (slot < 0)
+        Serial.printf("No macro %s\n", name);
+    return slot >= 0;
+}
+
+static void onStepDone(uint32_t seq, send_result_t result, uint8_t tries)
+{
+    if (!player.active || seq != player.awaitSeq)
+        return;
+    player.awaitSeq = 0;
+    if (result != SEND_ACKED)
+    {
+        Serial.printf("Macro %s stopped at step %u: no answer from the Hub\n", player.rec.name, player.next);
+        player.active = false;
+        return;
+    }
+    player.dueMs = millis(); // waits count from the acknowledged step
+}
+
+static void onUploadDone(uint32_t seq, send_result_t result, uint8_t tries)
+{
+    if (result == SEND_FAILED)
+        Serial.printf("Macro upload (seq %u): no answer from the Hub after %u tries\n", (unsigned)seq, tries);
+}
+
+static void playMacro(const char *name)
+{
+    if (!hubPaired())
+    {
+        Serial.println("Not paired with a Hub, type 'pair'");
+        return;
+    }
+    if (!loadMacro(name, &player.rec))
+        return;
+    player.next = 0;
+    player.awaitSeq = 0;
+    player.dueMs = millis();
+    player.active = true;
+    Serial.printf("Playing macro %s (%u ops), 'macro stop' to cancel\n", player.rec.name, player.rec.count);
+}
+
+static void uploadMacro(const char *name, uint8_t flags)
+{
+    static batch_message batch;
+    macro_rec_t rec;
+    if (!hubPaired())
+    {
+        Serial.println("Not paired with a Hub, type 'pair'");
+        return;
+    }
+    if (!loadMacro(name, &rec))
+        return;
+    if (sendQueueFull())
+    {
+        Serial.println("Send queue full, try again");
+        return;
+    }
+
+    memcpy(batch.ops, rec.ops, rec.count * sizeof(batch_op_t));
+    batch.count = rec.count;
+    batch.flags = flags;
+    stampHeader(&batch.hdr, MSG_BATCH);
+
+    uint32_t runMs = opScriptDurationMs(rec.ops, rec.count);
+    sendQueuePush(&batch, BATCH_MESSAGE_LEN(rec.count), runMs, onUploadDone);
+    Serial.printf("Uploaded macro %s as batch seq %u, the Hub runs it for %.1f s and ACKs at the end\n",
+                  rec.name, (unsigned)batch.hdr.seq, runMs / 1000.0f);
+}
+
+bool macroPlaying()
+{
+    return player.active;
+}
+
+void macroPoll()
+{
+    if (!player.active || player.awaitSeq != 0)
+        return;
+
+    while (player.next < player.rec.count)
+    {
+        if ((int32_t)(millis() - player.dueMs) < 0)
+            return;
+
+        const batch_op_t *op = &player.rec.ops[player.next];
+        if (op->opcode == OP_WAIT_MS)
+        {
+            player.dueMs += op->arg;
+            player.next++;
+            continue;
+        }
+
+        if (sendQueueFull())
+            return; // try again next loop
+
+        batch_message step;
+        step.ops[0] = *op;
+        step.count = 1;
+        step.flags = 0;
+        stampHeader(&step.hdr, MSG_BATCH);
+        Serial.printf("Macro %s step %u/%u: ", player.rec.name, player.next + 1, player.rec.count);
+        printOp(Serial, op);
+        Serial.println();
+
+        player.next++;
+        player.awaitSeq = step.hdr.seq;
+        sendQueuePush(&step, BATCH_MESSAGE_LEN(1), 0, onStepDone);
+        return;
+    }
+
+    Serial.printf("Macro %s done\n", player.rec.name);
+    player.active = false;
+}
+
+void macroCommand(const char *args)
+{
+    char verb[8] = "";
+    char name[MACRO_NAME_MAX + 2] = "";
+    int consumed = 0;
+    while (*args == ' ')
+        args++;
+    sscanf(args, "%7s %n", verb, &consumed);
+    args += consumed;
+
+    uint8_t flags = 0;
+    if (strcasecmp(verb, "upload") == 0 && strncmp(args, "-a ", 3) == 0)
+    {
+        flags |= BATCH_FLAG_ATOMIC;
+        args += 3;
+    }
+    consumed = 0;
+    sscanf(args, "%16s %n", name, &consumed);
+    const char *rest = args + consumed;
+
+    if (verb[0] == '\0' || strcasecmp(verb, "list") == 0)
+    {
+        listMacros();
+    }
+    else if ((strcasecmp(verb, "add") == 0 || strcasecmp(verb, "append") == 0) && name[0] && *rest)
+    {
+        storeMacro(name, rest, strcasecmp(verb, "append") == 0);
+    }
+    else if (strcasecmp(verb, "del") == 0 && name[0])
+    {
+        deleteMacro(name);
+    }
+    else if (strcasecmp(verb, "show") == 0 && name[0])
+    {
+        macro_rec_t rec;
+        if (loadMacro(name, &rec))
+            printMacro(&rec);
+    }
+    else if (strcasecmp(verb, "play") == 0 && name[0])
+    {
+        playMacro(name);
+    }
+    else if (strcasecmp(verb, "upload") == 0 && name[0])
+    {
+        uploadMacro(name, flags);
+    }
+    else if (strcasecmp(verb, "stop") == 0)
+    {
+        if (player.active)
+            Serial.printf("Macro %s stopped at step %u\n", player.rec.name, player.next);
+        player.active = false;
+    }
+    else
+    {
+        Serial.println("Usage: macro [list], macro add|append <name> <steps>, macro del|show <name>,");
+        Serial.println("       macro play <name>, macro upload [-a] <name>, macro stop");
+        Serial.println("Steps as for batch, e.g. macro add flush run 30s @1; wait 31s; run 30s @2");
+    }
+}
@@ -0,0 +1,20 @@
+// File: src/remote/macro.h
+// Named op scripts kept in NVS, e.g.
+//   macro add flush run 30s @1; wait 31s; run 30s @2
+// "macro play" steps through one locally: each switching op goes out as
+// a one-op batch through the send queue and a wait starts once the op
+// before it was acknowledged. "macro upload" sends the whole macro as a
+// single batch so the Hub runs it with its own timing, radio or not.
+#pragma once
+
+#include <Arduino.h>
+
+#define MACRO_SLOTS 8
+#define MACRO_NAME_MAX 15
+
+// "macro [list|add|append|del|show|play|upload|stop] ..."
+void macroCommand(const char *args);
+
+// Advances local playback, from loop()
+void macroPoll();
+bool macroPlaying();
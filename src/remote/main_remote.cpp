@@ -1,33 +1,541 @@
 #include <Arduino.h>
 #include <esp_now.h>
 #include <WiFi.h>
+#include <Preferences.h>
+#include "protocol.h"
+#include "key_util.h"
+#include "mac_util.h"
+#include "link_stats.h"
+#include "remote.h"
+#include "bench.h"
+#include "op_script.h"
+#include "pairing.h"
+#include "line_reader.h"
+#include "power.h"
+#include "send_queue.h"
+#include "macro.h"
 
 // --- CONFIGURATION ---
-// TARGET: Waveshare S3 Nano (Hub)
-// MAC Address: A0:85:E3:E1:2E:70
-uint8_t hubMacAddress[] = {0xA0, 0x85, 0xE3, 0xE1, 0x2E, 0x70};
-
-// Message Structure (Must match Hub)
-typedef struct struct_message
-{
-    char command[32];
-} struct_message;
+// The Hub's MAC and channel come from pairing (NVS), see pairing.h.
+// All zeros until this remote has been paired.
+uint8_t hubMacAddress[6] = {0};
+static uint8_t hubChannel = 0;
 
 struct_message myData;
+batch_message myBatch;
 esp_now_peer_info_t peerInfo;
 
-// Callback: Did the Hub receive the message?
+// Sequence numbers for the Hub's duplicate filter.
+// A new random session on every boot so the Hub never mistakes a fresh
+// seq 1 for a retransmit from before the reboot.
+uint32_t txSession = 0;
+uint32_t txSeq = 0;
+
+// --- ACK HANDLING ---
+// OnDataRecv only queues the ACK, loop() matches it against the send
+// time of its seq and prints the round trip.
+#define ACK_QUEUE_DEPTH 8
+#define PENDING_SLOTS 16
+
+// Holds either an ack_message or a batch_ack_message
+typedef struct rx_ack_t
+{
+    uint32_t rxMicros;
+    uint8_t len;
+    uint8_t data[sizeof(batch_ack_message)];
+} rx_ack_t;
+
+typedef struct pending_cmd_t
+{
+    uint32_t seq;
+    uint32_t sentMicros;
+} pending_cmd_t;
+
+static StaticQueue_t ackQueueBuffer;
+static uint8_t ackQueueStorage[ACK_QUEUE_DEPTH * sizeof(rx_ack_t)];
+static QueueHandle_t ackQueue = NULL;
+static pending_cmd_t pending[PENDING_SLOTS];
+
+// --- ENCRYPTION ---
+// PMK/LMK are provisioned over serial ("key pmk|lmk <hex>") and kept in NVS.
+// Use the same LMK as the Hub's "peer key" for this remote.
+static uint8_t pmk[KEY_LEN];
+static uint8_t lmk[KEY_LEN];
+static bool pmkSet = false;
+static bool lmkSet = false;
+
+// --- TELEMETRY ---
+// Latest broadcast from the Hub, copied in place by OnDataRecv
+static telemetry_message telemetry;
+static uint32_t telemetryRxMs = 0;
+static uint32_t telemetryCount = 0;
+static portMUX_TYPE telemetryLock = portMUX_INITIALIZER_UNLOCKED;
+
+// Serial console: fixed buffer, history, never blocks loop()
+#define CONSOLE_LINE_MAX 96
+#define CONSOLE_HISTORY 8
+static line_reader_t<CONSOLE_LINE_MAX, CONSOLE_HISTORY> serialLine;
+
+// Idle deep sleep, 0 = off. Kept in NVS as "sleep_s".
+static uint32_t autoSleepS = 0;
+static uint32_t lastActivityMs = 0;
+
+// Link quality to the Hub, written from the WiFi task
+static link_stats_t hubLink;
+static portMUX_TYPE linkLock = portMUX_INITIALIZER_UNLOCKED;
+
+// Callback: Did the Hub receive the message? Failures are retried by
+// the send queue.
 void OnDataSent(const uint8_t *mac_addr, esp_now_send_status_t status)
 {
-    Serial.print("\r\nPacket Status:\t");
-    Serial.println(status == ESP_NOW_SEND_SUCCESS ? "Delivery Success" : "Delivery Fail");
+    sendQueueOnSent(mac_addr, status == ESP_NOW_SEND_SUCCESS);
+
+    portENTER_CRITICAL(&linkLock);
+    linkOnSent(&hubLink, status == ESP_NOW_SEND_SUCCESS);
+    portEXIT_CRITICAL(&linkLock);
+}
+
+// Promiscuous callback, used only for the Hub's RSSI
+void OnPromiscuous(void *buf, wifi_promiscuous_pkt_type_t type)
+{
+    const uint8_t *mac;
+    int8_t rssi;
+    if (!linkParseEspNow(buf, type, &mac, &rssi) || memcmp(mac, hubMacAddress, 6) != 0)
+        return;
+
+    portENTER_CRITICAL(&linkLock);
+    linkOnRssi(&hubLink, rssi);
+    portEXIT_CRITICAL(&linkLock);
+}
+
+// Callback: ACK or benchmark reply from the Hub
+void OnDataRecv(const uint8_t *mac, const uint8_t *incomingData, int len)
+{
+    uint32_t now = micros();
+    if (len < (int)sizeof(msg_header_t) || pairingOnFrame(mac, incomingData, len))
+        return;
+    if (memcmp(mac, hubMacAddress, 6) != 0)
+        return;
+
+    // Telemetry carries the Hub's own sequence, replies echo ours
+    portENTER_CRITICAL(&linkLock);
+    if (incomingData[0] == MSG_TELEMETRY)
+        linkOnFrame(&hubLink, ((const msg_header_t *)incomingData)->session,
+                    ((const msg_header_t *)incomingData)->seq, false);
+    else
+        linkOnRx(&hubLink);
+    portEXIT_CRITICAL(&linkLock);
+
+    if (incomingData[0] == MSG_BENCH_PONG && len == sizeof(bench_message))
+    {
+        benchOnPong(incomingData, now);
+        return;
+    }
+
+    if (incomingData[0] == MSG_TELEMETRY && len == sizeof(telemetry_message))
+    {
+        portENTER_CRITICAL(&telemetryLock);
+        memcpy(&telemetry, incomingData, sizeof(telemetry));
+        telemetryRxMs = millis();
+        telemetryCount++;
+        portEXIT_CRITICAL(&telemetryLock);
+        return;
+    }
+
+    bool isAck = incomingData[0] == MSG_ACK && len == sizeof(ack_message);
+    bool isBatchAck = incomingData[0] == MSG_BATCH_ACK && len >= (int)BATCH_ACK_LEN(0) &&
+                      len <= (int)sizeof(batch_ack_message);
+    if (!isAck && !isBatchAck)
+        return;
+
+    rx_ack_t item;
+    item.rxMicros = now;
+    item.len = (uint8_t)len;
+    memcpy(item.data, incomingData, len);
+    if (((const msg_header_t *)item.data)->session != txSession)
+        return;
+
+    xQueueSend(ackQueue, &item, 0);
+}
+
+bool hubKeyInstalled()
+{
+    return lmkSet;
+}
+
+bool hubPaired()
+{
+    return hubChannel != 0;
+}
+
+bool connectHub(const uint8_t *mac, uint8_t channel, bool encrypt)
+{
+    if (esp_now_is_peer_exist(hubMacAddress))
+        esp_now_del_peer(hubMacAddress);
+
+    memcpy(hubMacAddress, mac, 6);
+    hubChannel = channel;
+    esp_wifi_set_channel(channel, WIFI_SECOND_CHAN_NONE);
+
+    portENTER_CRITICAL(&linkLock);
+    linkReset(&hubLink, mac);
+    portEXIT_CRITICAL(&linkLock);
+
+    memset(&peerInfo, 0, sizeof(peerInfo));
+    memcpy(peerInfo.peer_addr, mac, 6);
+    peerInfo.channel = 0; // whatever the radio is on, set just above
+    peerInfo.encrypt = encrypt && lmkSet;
+    if (peerInfo.encrypt)
+        memcpy(peerInfo.lmk, lmk, KEY_LEN);
+    return esp_now_add_peer(&peerInfo) == ESP_OK;
+}
+
+bool setHubEncryption(bool encrypt)
+{
+    peerInfo.encrypt = encrypt && lmkSet;
+    if (peerInfo.encrypt)
+        memcpy(peerInfo.lmk, lmk, KEY_LEN);
+    return esp_now_mod_peer(&peerInfo) == ESP_OK;
+}
+
+void loadKeys()
+{
+    Preferences prefs;
+    if (!prefs.begin("remote", true))
+        return;
+    pmkSet = prefs.getBytes("pmk", pmk, KEY_LEN) == KEY_LEN;
+    lmkSet = prefs.getBytes("lmk", lmk, KEY_LEN) == KEY_LEN;
+    autoSleepS = prefs.getUInt("sleep_s", 0);
+    prefs.end();
+}
+
+void handleKeyCommand(const char *args)
+{
+    char which[8] = "";
+    char hex[40] = "";
+    sscanf(args, "%7s %39s", which, hex);
+
+    Preferences prefs;
+    prefs.begin("remote", false);
+    if (strcasecmp(which, "clear") == 0)
+    {
+        prefs.remove("pmk");
+        prefs.remove("lmk");
+        pmkSet = lmkSet = false;
+        setHubEncryption(false);
+        Serial.println("Keys cleared, link is unencrypted");
+    }
+    else if (strcasecmp(which, "pmk") == 0 && parseKey(hex, pmk))
+    {
+        prefs.putBytes("pmk", pmk, KEY_LEN);
+        pmkSet = true;
+        esp_now_set_pmk(pmk);
+        Serial.println("PMK saved");
+    }
+    else if (strcasecmp(which, "lmk") == 0 && parseKey(hex, lmk))
+    {
+        prefs.putBytes("lmk", lmk, KEY_LEN);
+        lmkSet = true;
+        Serial.println(setHubEncryption(true) ? "LMK saved, link is encrypted" : "LMK saved, but ESP-NOW rejected it");
+    }
+    else
+    {
+        Serial.printf("PMK %s, LMK %s, link %s\n", pmkSet ? "set" : "unset", lmkSet ? "set" : "unset",
+                      peerInfo.encrypt ? "encrypted" : "plain");
+        Serial.println("Usage: key pmk|lmk <32 hex digits>, key clear");
+    }
+    prefs.end();
+}
+
+// Hands the current link to the wake path and sleeps, does not return
+void enterSleep()
+{
+    power_link_t link;
+    memset(&link, 0, sizeof(link));
+    memcpy(link.hubMac, hubMacAddress, 6);
+    link.channel = hubChannel;
+    link.hasPmk = pmkSet;
+    link.hasLmk = peerInfo.encrypt;
+    memcpy(link.pmk, pmk, KEY_LEN);
+    memcpy(link.lmk, lmk, KEY_LEN);
+    link.session = txSession;
+    link.seq = txSeq;
+    powerSleep(&link);
+}
+
+// "sleep", "sleep auto <s>|off", "sleep stats"
+void handleSleepCommand(const char *args)
+{
+    while (*args == ' ')
+        args++;
+
+    if (strcasecmp(args, "stats") == 0)
+    {
+        powerPrintStats();
+    }
+    else if (strncasecmp(args, "auto ", 5) == 0)
+    {
+        autoSleepS = strcasecmp(args + 5, "off") == 0 ? 0 : (uint32_t)atol(args + 5);
+        Preferences prefs;
+        prefs.begin("remote", false);
+        prefs.putUInt("sleep_s", autoSleepS);
+        prefs.end();
+        if (autoSleepS > 0)
+            Serial.printf("Sleeping after %u s idle\n", (unsigned)autoSleepS);
+        else
+            Serial.println("Auto sleep off");
+    }
+    else if (*args != '\0')
+    {
+        Serial.println("Usage: sleep, sleep auto <s>|off, sleep stats");
+    }
+    else if (!hubPaired())
+    {
+        Serial.println("Not paired with a Hub, type 'pair'");
+    }
+    else if (sendQueuePending() > 0)
+    {
+        Serial.printf("%u command(s) still in the send queue, try again\n", (unsigned)sendQueuePending());
+    }
+    else
+    {
+        enterSleep();
+    }
+}
+
+const char *ackStatusName(uint8_t status)
+{
+    switch (status)
+    {
+    case ACK_OK:
+        return "OK";
+    case ACK_DUPLICATE:
+        return "DUPLICATE";
+    case ACK_DENIED:
+        return "DENIED";
+    case ACK_SKIPPED:
+        return "SKIPPED";
+    case ACK_BUSY:
+        return "BUSY";
+    case ACK_LOCKOUT:
+        return "LOCKOUT";
+    case ACK_INTERLOCK:
+        return "INTERLOCK";
+    case ACK_TOO_LONG:
+        return "TOO_LONG";
+    default:
+        return "UNKNOWN";
+    }
+}
+
+// "OFF" or the open zones such as "ON @12", from a relayOn zone mask
+const char *zoneMaskText(uint8_t mask, char *buf, size_t len)
+{
+    if (mask == 0)
+        return "OFF";
+    int n = snprintf(buf, len, "ON @");
+    for (uint8_t i = 0; i < 8 && n < (int)len - 1; i++)
+        if (mask & (1 << i))
+            buf[n++] = '1' + i;
+    buf[n] = '\0';
+    return buf;
+}
+
+void printLink()
+{
+    link_stats_t copy;
+    portENTER_CRITICAL(&linkLock);
+    copy = hubLink;
+    portEXIT_CRITICAL(&linkLock);
+
+    Serial.println("Link to Hub:");
+    linkPrint(Serial, &copy);
+}
+
+void printTelemetry()
+{
+    telemetry_message t;
+    uint32_t rxMs, count;
+
+    portENTER_CRITICAL(&telemetryLock);
+    t = telemetry;
+    rxMs = telemetryRxMs;
+    count = telemetryCount;
+    portEXIT_CRITICAL(&telemetryLock);
+
+    if (count == 0)
+    {
+        Serial.println("No telemetry received from the Hub yet");
+        return;
+    }
+
+    const sensor_sample_t *s = &t.sample;
+    Serial.printf("Hub telemetry #%u (%u ms ago):\n", (unsigned)t.hdr.seq, (unsigned)(millis() - rxMs));
+    if (s->flags & SAMPLE_FLAG_NO_BME)
+        Serial.println("  Temp/Humidity/Pressure: sensor missing");
+    else
+        Serial.printf("  Temp %.2f C, Humidity %.1f %%, Pressure %.1f hPa\n",
+                      s->tempCenti / 100.0f, s->humidityCenti / 100.0f, s->pressurePa / 100.0f);
+    if (!(s->flags & SAMPLE_FLAG_NO_LIGHT))
+        Serial.printf("  Light %u lux\n", s->lux);
+    char zones[16];
+    Serial.printf("  Rain %s, Fert pin %u, Pump %s (duty %.1f %% last hour)\n",
+                  s->rain == LOW ? "WET" : "dry", s->fert, zoneMaskText(s->relayOn, zones, sizeof(zones)),
+                  s->relayDutyPermille / 10.0f);
+}
+
+// Prints the round trip for seq if it is still pending
+void printRtt(uint32_t seq, uint32_t rxMicros)
+{
+    pending_cmd_t *p = &pending[seq % PENDING_SLOTS];
+    if (p->seq == seq)
+    {
+        Serial.printf(", RTT %.2f ms\n", (rxMicros - p->sentMicros) / 1000.0f);
+        p->seq = 0; // only the first ACK of a seq gets a latency
+    }
+    else
+    {
+        Serial.println();
+    }
+}
+
+void processAcks()
+{
+    rx_ack_t item;
+    char zones[16];
+    while (xQueueReceive(ackQueue, &item, 0) == pdTRUE)
+    {
+        sendQueueOnAck(((const msg_header_t *)item.data)->seq);
+        if (item.data[0] == MSG_ACK)
+        {
+            const ack_message *ack = (const ack_message *)item.data;
+            Serial.printf("ACK seq %u: %s, Pump %s (hub t=%u ms)",
+                          (unsigned)ack->hdr.seq, ackStatusName(ack->status),
+                          zoneMaskText(ack->relayOn, zones, sizeof(zones)),
+                          (unsigned)ack->hubTimeMs);
+            printRtt(ack->hdr.seq, item.rxMicros);
+        }
+        else
+        {
+            const batch_ack_message *ack = (const batch_ack_message *)item.data;
+            uint8_t count = min((size_t)ack->count, (size_t)(item.len - BATCH_ACK_LEN(0)));
+            Serial.printf("Batch ACK seq %u: Pump %s (hub t=%u ms)",
+                          (unsigned)ack->hdr.seq, zoneMaskText(ack->relayOn, zones, sizeof(zones)),
+                          (unsigned)ack->hubTimeMs);
+            printRtt(ack->hdr.seq, item.rxMicros);
+            for (uint8_t i = 0; i < count; i++)
+                Serial.printf("  %2u: %s\n", i + 1, ackStatusName(ack->status[i]));
+        }
+    }
+}
+
+// Fills in the header and remembers the send time for the RTT
+void stampHeader(msg_header_t *hdr, uint8_t type)
+{
+    hdr->type = type;
+    hdr->version = PROTOCOL_VERSION;
+    hdr->reserved = 0;
+    hdr->session = txSession;
+    hdr->seq = ++txSeq;
+
+    pending_cmd_t *p = &pending[txSeq % PENDING_SLOTS];
+    p->seq = txSeq;
+    p->sentMicros = micros();
+}
+
+// Completion of a queued frame; ACKs themselves are printed by processAcks()
+void onSendDone(uint32_t seq, send_result_t result, uint8_t tries)
+{
+    if (result == SEND_FAILED)
+        Serial.printf("Seq %u: no answer from the Hub after %u tries, giving up\n", (unsigned)seq, tries);
+    else if (result == SEND_FLUSHED)
+        Serial.printf("Seq %u: dropped\n", (unsigned)seq);
+}
+
+// "batch [-a] on; wait 5s; off"  (-a: atomic, all or nothing)
+void handleBatchCommand(const char *args)
+{
+    while (*args == ' ')
+        args++;
+
+    uint8_t flags = 0;
+    if (strncmp(args, "-a ", 3) == 0)
+    {
+        flags |= BATCH_FLAG_ATOMIC;
+        args += 3;
+    }
+
+    const char *error = "";
+    int count = parseOpScript(args, myBatch.ops, BATCH_MAX_OPS, &error);
+    if (count < 0)
+    {
+        Serial.printf("Batch error: %s\n", error);
+        Serial.println("Usage: batch [-a] on; wait 5s; off; t");
+        return;
+    }
+
+    myBatch.count = (uint8_t)count;
+    myBatch.flags = flags;
+    Serial.printf("Sending batch of %d op(s)%s:\n", count, (flags & BATCH_FLAG_ATOMIC) ? " (atomic)" : "");
+    for (int i = 0; i < count; i++)
+    {
+        Serial.printf("  %2d: ", i + 1);
+        printOp(Serial, &myBatch.ops[i]);
+        Serial.println();
+    }
+
+    if (!hubPaired())
+    {
+        Serial.println("Not paired with a Hub, type 'pair'");
+        return;
+    }
+    if (sendQueueFull())
+    {
+        Serial.println("Send queue full, try again");
+        return;
+    }
+    stampHeader(&myBatch.hdr, MSG_BATCH);
+    sendQueuePush(&myBatch, BATCH_MESSAGE_LEN(count), opScriptDurationMs(myBatch.ops, count), onSendDone);
+}
+
+// Queues myData.command for the Hub, returns at once
+void sendCommand()
+{
+    if (!hubPaired())
+    {
+        Serial.println("Not paired with a Hub, type 'pair'");
+        return;
+    }
+    if (sendQueueFull())
+    {
+        Serial.println("Send queue full, try again");
+        return;
+    }
+
+    stampHeader(&myData.hdr, MSG_COMMAND);
+    sendQueuePush(&myData, sizeof(myData), 0, onSendDone);
 }
 
 void setup()
 {
+    // Button wake: send and sleep again before anything else starts
+    powerHandleWake();
+
     Serial.begin(115200);
+    powerBeginButtons();
+    lineReaderInit(&serialLine, true);
     WiFi.mode(WIFI_STA);
 
+    do
+    {
+        txSession = esp_random();
+    } while (txSession == 0);
+
+    ackQueue = xQueueCreateStatic(ACK_QUEUE_DEPTH, sizeof(rx_ack_t), ackQueueStorage, &ackQueueBuffer);
+    benchBegin();
+    sendQueueBegin();
+    loadKeys();
+
     if (esp_now_init() != ESP_OK)
     {
         Serial.println("Error initializing ESP-NOW");
@@ -35,54 +543,180 @@ void setup()
     }
 
     esp_now_register_send_cb(OnDataSent);
+    esp_now_register_recv_cb(OnDataRecv);
+    linkEnableRssi(OnPromiscuous);
+    if (pmkSet)
+        esp_now_set_pmk(pmk);
 
-    // Register the Hub as a peer
-    memcpy(peerInfo.peer_addr, hubMacAddress, 6);
-    peerInfo.channel = 0;
-    peerInfo.encrypt = false;
-
-    if (esp_now_add_peer(&peerInfo) != ESP_OK)
+    // Reconnect to the stored Hub without scanning, pair on first boot
+    uint8_t mac[6];
+    uint8_t channel;
+    if (pairingLoad(mac, &channel))
     {
-        Serial.println("Failed to add peer");
-        return;
+        if (connectHub(mac, channel, true))
+            Serial.printf("Hub " MAC_FMT " on channel %u, ready %u ms after boot\n", MAC_ARGS(mac), channel,
+                          (unsigned)millis());
+        else
+            Serial.println("Failed to add peer");
+    }
+    else
+    {
+        Serial.println("Not paired yet");
+        pairingStart();
     }
 
     Serial.println("--- REMOTE READY ---");
-    Serial.println("Type 't' to toggle pump, 'on' for ON, 'off' for OFF.");
+    Serial.println("Type 't' to toggle pump, 'on' for ON, 'off' for OFF, 'run <sec>' for a timed run,");
+    Serial.println("'zones 12' / 'zones off' to pick the open zones.");
+    Serial.println("'batch on; wait 5s; off' sends a sequence in one frame, 'macro' stores named ones.");
+    Serial.println("'status' shows the latest Hub telemetry, 'link' the radio statistics, 'queue' the send queue.");
+    Serial.println("'key' manages encryption keys, 'bench [n]' measures the link,");
+    Serial.println("'bench ping|gpio [n] [rate/s]' gives latency percentiles.");
+    Serial.println("'pair' finds a Hub in pairing mode, 'unpair' forgets the stored one.");
+    Serial.println("'sleep' enters deep sleep, the buttons then wake it to send.");
+    lastActivityMs = millis();
 }
 
 void loop()
 {
-    if (Serial.available())
+    processAcks();
+
+    // While pairing the radio is off the Hub's channel, so sending waits
+    pairingPoll();
+    if (!pairingActive())
+    {
+        sendQueuePoll();
+        macroPoll();
+    }
+
+    const char *button = powerPollButtons();
+    if (button != NULL && pairingActive())
+    {
+        Serial.printf("Button: %s ignored, pairing in progress\n", button);
+    }
+    else if (button != NULL)
     {
-        String input = Serial.readStringUntil('\n');
-        input.trim();
+        lastActivityMs = millis();
+        strcpy(myData.command, button);
+        Serial.printf("Button: %s\n", button);
+        sendCommand();
+    }
 
-        if (input.equalsIgnoreCase("t") || input.equalsIgnoreCase("toggle"))
+    if (autoSleepS > 0 && hubPaired() && !pairingActive() && sendQueuePending() == 0 && !macroPlaying() && millis() - lastActivityMs >= autoSleepS * 1000UL)
+        enterSleep();
+
+    const char *text = lineReaderPoll(&serialLine, Serial, &Serial);
+    if (text != NULL)
+    {
+        lastActivityMs = millis();
+        if (pairingActive())
+        {
+            Serial.println("Pairing in progress, try again when it is done");
+            return;
+        }
+        if (strncasecmp(text, "sleep", 5) == 0 && (text[5] == ' ' || text[5] == '\0'))
+        {
+            handleSleepCommand(text + 5);
+            return;
+        }
+        else if (strncasecmp(text, "key", 3) == 0 && (text[3] == ' ' || text[3] == '\0'))
+        {
+            handleKeyCommand(text + 3);
+            return;
+        }
+        else if (strcasecmp(text, "status") == 0)
+        {
+            printTelemetry();
+            return;
+        }
+        else if (strcasecmp(text, "link") == 0)
+        {
+            printLink();
+            return;
+        }
+        else if (strcasecmp(text, "queue") == 0)
+        {
+            sendQueuePrint(Serial);
+            return;
+        }
+        else if (strcasecmp(text, "pair") == 0)
+        {
+            pairingStart();
+            return;
+        }
+        else if (strcasecmp(text, "unpair") == 0)
+        {
+            pairingForget();
+            Serial.println("Stored Hub forgotten, 'pair' to pair again");
+            return;
+        }
+        else if (strncasecmp(text, "macro", 5) == 0 && (text[5] == ' ' || text[5] == '\0'))
+        {
+            macroCommand(text + 5);
+            return;
+        }
+        else if (strncasecmp(text, "batch", 5) == 0 && (text[5] == ' ' || text[5] == '\0'))
+        {
+            handleBatchCommand(text + 5);
+            return;
+        }
+        else if (strncasecmp(text, "bench ping", 10) == 0 || strncasecmp(text, "bench gpio", 10) == 0)
+        {
+            // "bench ping|gpio [n] [rate/s]"
+            unsigned long count = 0, rate = 0;
+            sscanf(text + 10, "%lu %lu", &count, &rate);
+            benchLatency(count > 0 ? count : BENCH_LATENCY_DEFAULT_COUNT, rate, tolower(text[6]) == 'g');
+            return;
+        }
+        else if (strncasecmp(text, "bench", 5) == 0 && (text[5] == ' ' || text[5] == '\0'))
+        {
+            long count = atol(text + 5);
+            benchRun(count > 0 ? count : BENCH_DEFAULT_COUNT);
+            return;
+        }
+        else if (strcasecmp(text, "t") == 0 || strcasecmp(text, "toggle") == 0)
         {
             strcpy(myData.command, "TOGGLE_PUMP");
             Serial.println("Sending: TOGGLE_PUMP");
         }
-        else if (input.equalsIgnoreCase("on"))
+        else if (strcasecmp(text, "on") == 0)
         {
             strcpy(myData.command, "PUMP_ON");
             Serial.println("Sending: PUMP_ON");
         }
-        else if (input.equalsIgnoreCase("off"))
+        else if (strcasecmp(text, "off") == 0)
         {
             strcpy(myData.command, "PUMP_OFF");
             Serial.println("Sending: PUMP_OFF");
         }
+        else if (strncasecmp(text, "run ", 4) == 0 && atol(text + 4) > 0)
+        {
+            snprintf(myData.command, sizeof(myData.command), "PUMP_RUN:%ld", atol(text + 4));
+            Serial.printf("Sending: %s\n", myData.command);
+        }
+        else if (strncasecmp(text, "zones ", 6) == 0)
+        {
+            // "zones 12" opens exactly zones 1 and 2, "zones off" closes all
+            unsigned mask = 0;
+            const char *p = text + 6;
+            if (strcasecmp(p, "off") != 0)
+            {
+                for (; *p >= '1' && *p <= '8'; p++)
+                    mask |= 1u << (*p - '1');
+                if (*p != '\0' || mask == 0)
+                {
+                    Serial.println("Usage: zones <zone digits>|off, e.g. zones 12");
+                    return;
+                }
+            }
+            snprintf(myData.command, sizeof(myData.command), "ZONES:%u", mask);
+            Serial.printf("Sending: %s\n", myData.command);
+        }
         else
         {
             return;
         }
 
-        esp_err_t result = esp_now_send(hubMacAddress, (uint8_t *)&myData, sizeof(myData));
-
-        if (result != ESP_OK)
-        {
-            Serial.println("Error sending data");
-        }
+        sendCommand();
     }
 }
\ No newline at end of file
@@ -0,0 +1,208 @@
+// File: src/remote/op_script.cpp
+#include "op_script.h"
+
+#define STEP_MAX 32
+
+// Parses "<n>", "<n>ms", "<n>s" or "<n>m" into milliseconds.
+// A bare number means defaultUnitMs.
+static bool parseDuration(const char *text, uint32_t defaultUnitMs, uint32_t *ms)
+{
+    char *end = NULL;
+    unsigned long v = strtoul(text, &end, 10);
+    if (end == text)
+        return false;
+    if (*end == '\0')
+        *ms = v * defaultUnitMs;
+    else if (strcasecmp(end, "ms") == 0)
+        *ms = v;
+    else if (strcasecmp(end, "s") == 0)
+        *ms = v * 1000UL;
+    else if (strcasecmp(end, "m") == 0)
+        *ms = v * 60000UL;
+    else
+        return false;
+    return true;
+}
+
+// Parses "@<zone digits>" such as "@2" or "@13" into a zone mask
+static bool parseZones(const char *text, uint8_t *mask)
+{
+    *mask = 0;
+    if (*text++ != '@' || *text == '\0')
+        return false;
+    for (; *text != '\0'; text++)
+    {
+        if (*text < '1' || *text > '8')
+            return false;
+        *mask |= 1 << (*text - '1');
+    }
+    return true;
+}
+
+static bool parseStep(char *step, batch_op_t *op, const char **error)
+{
+    char *save = NULL;
+    char *word = strtok_r(step, " \t", &save);
+    char *arg = NULL;
+    char *tok;
+
+    memset(op, 0, sizeof(*op));
+    if (word == NULL)
+    {
+        *error = "empty step";
+        return false;
+    }
+
+    // Remaining tokens: at most one argument and an optional zone list
+    while ((tok = strtok_r(NULL, " \t", &save)) != NULL)
+    {
+        if (tok[0] == '@')
+        {
+            if (!parseZones(tok, &op->target))
+            {
+                *error = "zones are @ followed by zone numbers, e.g. @12";
+                return false;
+            }
+        }
+        else if (arg == NULL)
+            arg = tok;
+        else
+        {
+            *error = "too many arguments";
+            return false;
+        }
+    }
+
+    if (strcasecmp(word, "zones") == 0)
+    {
+        // "zones @12" opens exactly zones 1 and 2, "zones off" closes all
+        if (op->target == 0 && (arg == NULL || strcasecmp(arg, "off") != 0))
+        {
+            *error = "zones needs @<zones> or off";
+            return false;
+        }
+        op->opcode = OP_ZONE_SET;
+    }
+    else if (strcasecmp(word, "on") == 0)
+        op->opcode = OP_PUMP_ON;
+    else if (strcasecmp(word, "off") == 0)
+        op->opcode = OP_PUMP_OFF;
+    else if (strcasecmp(word, "t") == 0 || strcasecmp(word, "toggle") == 0)
+        op->opcode = OP_TOGGLE_PUMP;
+    else if (strcasecmp(word, "wait") == 0)
+    {
+        uint32_t ms;
+        if (arg == NULL || !parseDuration(arg, 1, &ms) || ms > UINT16_MAX)
+        {
+            *error = "wait needs a duration up to 65535 ms";
+            return false;
+        }
+        op->opcode = OP_WAIT_MS;
+        op->arg = (uint16_t)ms;
+    }
+    else if (strcasecmp(word, "run") == 0)
+    {
+        uint32_t ms;
+        if (arg == NULL || !parseDuration(arg, 1000, &ms) || ms < 1000 || ms / 1000 > UINT16_MAX)
+        {
+            *error = "run needs a duration of at least 1 s";
+            return false;
+        }
+        op->opcode = OP_PUMP_RUN;
+        op->arg = (uint16_t)(ms / 1000);
+    }
+    else
+    {
+        *error = "unknown step";
+        return false;
+    }
+    return true;
+}
+
+int parseOpScript(const char *text, batch_op_t *ops, int maxOps, const char **error)
+{
+    int count = 0;
+    const char *p = text;
+
+    while (*p != '\0')
+    {
+        size_t len = strcspn(p, ";,");
+        char step[STEP_MAX];
+        if (len >= sizeof(step))
+        {
+            *error = "step too long";
+            return -1;
+        }
+        memcpy(step, p, len);
+        step[len] = '\0';
+        p += len;
+        if (*p != '\0')
+            p++;
+
+        if (strspn(step, " \t") == len)
+            continue; // tolerate "a;;b" and a trailing ';'
+
+        if (count >= maxOps)
+        {
+            *error = "too many steps";
+            return -1;
+        }
+        if (!parseStep(step, &ops[count], error))
+            return -1;
+        count++;
+    }
+
+    if (count == 0)
+    {
+        *error = "no steps";
+        return -1;
+    }
+    return count;
+}
+
+uint32_t opScriptDurationMs(const batch_op_t *ops, int count)
+{
+    uint32_t ms = 0;
+    for (int i = 0; i < count; i++)
+        if (ops[i].opcode == OP_WAIT_MS)
+            ms += ops[i].arg;
+    return ms;
+}
+
+void printOp(Print &out, const batch_op_t *op)
+{
+    switch (op->opcode)
+    {
+    case OP_PUMP_ON:
+        out.print("PUMP_ON");
+        break;
+    case OP_PUMP_OFF:
+        out.print("PUMP_OFF");
+        break;
+    case OP_TOGGLE_PUMP:
+        out.print("TOGGLE_PUMP");
+        break;
+    case OP_WAIT_MS:
+        out.printf("WAIT %u ms", op->arg);
+        break;
+    case OP_PUMP_RUN:
+        out.printf("PUMP_RUN %u s", op->arg);
+        break;
+    case OP_ZONE_SET:
+        out.print("ZONE_SET");
+        break;
+    default:
+        out.printf("OP 0x%02X", op->opcode);
+        break;
+    }
+
+    if (op->target != 0)
+    {
+        out.print(" @");
+        for (uint8_t i = 0; i < 8; i++)
+            if (op->target & (1 << i))
+                out.print((char)('1' + i));
+    }
+    else if (op->opcode == OP_ZONE_SET)
+        out.print(" (all off)");
+}
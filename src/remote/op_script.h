@@ -0,0 +1,21 @@
+// File: src/remote/op_script.h
+// Turns a typed sequence such as "on; wait 2s; off" into batch ops.
+// Steps are separated by ';' or ','. Recognised steps:
+//   on | off | t | toggle | run <n>[s|m] | wait <n>[ms|s|m] | zones off
+// A bare number is seconds for run and milliseconds for wait.
+// Switching steps take an optional zone list, "@12" = zones 1 and 2;
+// without one the hub uses its default zone. "zones @12" opens exactly
+// those zones and closes the rest.
+#pragma once
+
+#include <Arduino.h>
+#include "protocol.h"
+
+// Returns the number of ops written, or -1 with *error set
+int parseOpScript(const char *text, batch_op_t *ops, int maxOps, const char **error);
+
+// Sum of the waits, i.e. how long the Hub takes to run the ops
+uint32_t opScriptDurationMs(const batch_op_t *ops, int count);
+
+// Human-readable form of one op, for echoing what will be sent
+void printOp(Print &out, const batch_op_t *op);
@@ -0,0 +1,221 @@
+// File: src/remote/pairing.cpp
+#include "pairing.h"
+#include <esp_now.h>
+#include <esp_wifi.h>
+#include <Preferences.h>
+#include "protocol.h"
+#include "mac_util.h"
+#include "remote.h"
+#include "send_queue.h"
+
+// Written by the receive callback, read by pairingPoll
+static volatile bool scanning = false;
+static volatile bool beaconSeen = false;
+static volatile bool acceptSeen = false;
+static uint8_t beaconMac[6];
+static uint8_t beaconChannel = 0;
+static uint32_t requestSeq = 0;
+static uint8_t acceptRole = 0;
+static portMUX_TYPE pairLock = portMUX_INITIALIZER_UNLOCKED;
+
+bool pairingLoad(uint8_t *mac, uint8_t *channel)
+{
+    bool ok = false;
+    Preferences prefs;
+    if (prefs.begin("remote", true))
+    {
+        ok = prefs.getBytes("hub", mac, 6) == 6;
+        *channel = prefs.getUChar("chan", 0);
+        prefs.end();
+    }
+    return ok && *channel >= 1 && *channel <= 13;
+}
+
+void pairingForget()
+{
+    Preferences prefs;
+    prefs.begin("remote", false);
+    prefs.remove("hub");
+    prefs.remove("chan");
+    prefs.end();
+}
+
+bool pairingOnFrame(const uint8_t *mac, const uint8_t *data, int len)
+{
+    if (len != sizeof(pair_message) || (data[0] != MSG_PAIR_BEACON && data[0] != MSG_PAIR_ACCEPT))
+        return false;
+    if (!scanning)
+        return true;
+
+    const pair_message *msg = (const pair_message *)data;
+    portENTER_CRITICAL(&pairLock);
+    if (msg->hdr.type == MSG_PAIR_BEACON && !beaconSeen)
+    {
+        memcpy(beaconMac, mac, 6);
+        beaconChannel = msg->channel;
+        beaconSeen = true;
+    }
+    else if (msg->hdr.type == MSG_PAIR_ACCEPT && beaconSeen && memcmp(mac, beaconMac, 6) == 0 &&
+             msg->hdr.session == txSession && msg->hdr.seq == requestSeq)
+    {
+        acceptRole = msg->role;
+        acceptSeen = true;
+    }
+    portEXIT_CRITICAL(&pairLock);
+    return true;
+}
+
+// --- STATE MACHINE ---
+// pairingPoll() advances one step at a time, so loop() keeps running
+// while the remote listens on each channel and waits for the accept.
+#define PAIR_IDLE 0
+#define PAIR_LISTEN 1  // hopping over channels 1..13 for a beacon
+#define PAIR_REQUEST 2 // request sent, waiting for the accept
+
+static uint8_t state = PAIR_IDLE;
+static uint8_t listenChannel = 0;
+static uint8_t scanPass = 0;
+static uint8_t requestTries = 0;
+static uint32_t stepStartMs = 0; // on this channel, or since the request
+static uint32_t pairStartMs = 0;
+
+// Hub to go back to if pairing fails
+static bool hadHub = false;
+static uint8_t oldMac[6];
+static uint8_t oldChannel = 0;
+
+// Hub the beacon came from
+static uint8_t foundMac[6];
+static uint8_t foundChannel = 0;
+
+static void listenOn(uint8_t ch)
+{
+    listenChannel = ch;
+    esp_wifi_set_channel(ch, WIFI_SECOND_CHAN_NONE);
+    stepStartMs = millis();
+}
+
+static void sendRequest()
+{
+    pair_message req;
+    memset(&req, 0, sizeof(req));
+    req.hdr.type = MSG_PAIR_REQUEST;
+    req.hdr.version = PROTOCOL_VERSION;
+    req.hdr.session = txSession;
+    portENTER_CRITICAL(&pairLock);
+    req.hdr.seq = ++requestSeq;
+    portEXIT_CRITICAL(&pairLock);
+
+    requestTries++;
+    stepStartMs = millis();
+    // A failed send is retried once the accept timeout has passed
+    sendQueueSendDirect(hubMacAddress, (uint8_t *)&req, sizeof(req));
+}
+
+static void finish(bool ok, uint8_t role)
+{
+    scanning = false;
+    state = PAIR_IDLE;
+
+    if (!ok)
+    {
+        if (hadHub)
+            connectHub(oldMac, oldChannel, true);
+        return;
+    }
+
+    Preferences prefs;
+    prefs.begin("remote", false);
+    prefs.putBytes("hub", foundMac, 6);
+    prefs.putUChar("chan", foundChannel);
+    prefs.end();
+
+    connectHub(foundMac, foundChannel, true);
+    Serial.printf("Pairing: done in %u ms, role %s\n", (unsigned)(millis() - pairStartMs),
+                  role == ROLE_READ_ONLY ? "read-only" : "control");
+}
+
+bool pairingStart()
+{
+    if (state != PAIR_IDLE)
+        return false;
+
+    hadHub = pairingLoad(oldMac, &oldChannel);
+    pairStartMs = millis();
+
+    Serial.println("Pairing: listening for a Hub beacon (open pairing on the Hub with 'pair')");
+    beaconSeen = false;
+    acceptSeen = false;
+    scanning = true;
+    scanPass = 0;
+    listenOn(1);
+    state = PAIR_LISTEN;
+    return true;
+}
+
+bool pairingActive()
+{
+    return state != PAIR_IDLE;
+}
+
+void pairingPoll()
+{
+    if (state == PAIR_LISTEN)
+    {
+        if (beaconSeen)
+        {
+            Serial.println();
+            portENTER_CRITICAL(&pairLock);
+            memcpy(foundMac, beaconMac, 6);
+            foundChannel = beaconChannel;
+            portEXIT_CRITICAL(&pairLock);
+
+            if (foundChannel < 1 || foundChannel > 13)
+            {
+                Serial.println("Pairing: beacon with an invalid channel");
+                finish(false, 0);
+                return;
+            }
+            // Plain until accepted, the Hub has no key for a new remote yet
+            Serial.printf("Pairing: Hub " MAC_FMT " on channel %u\n", MAC_ARGS(foundMac), foundChannel);
+            connectHub(foundMac, foundChannel, false);
+            requestTries = 0;
+            sendRequest();
+            state = PAIR_REQUEST;
+            return;
+        }
+        if (millis() - stepStartMs < PAIR_LISTEN_MS)
+            return;
+        if (listenChannel < 13)
+        {
+            listenOn(listenChannel + 1);
+            return;
+        }
+        Serial.print(".");
+        if (++scanPass >= PAIR_SCAN_PASSES)
+        {
+            Serial.println();
+            Serial.println("Pairing: no Hub found");
+            finish(false, 0);
+            return;
+        }
+        listenOn(1);
+    }
+    else if (state == PAIR_REQUEST)
+    {
+        if (acceptSeen)
+        {
+            finish(true, acceptRole);
+            return;
+        }
+        if (millis() - stepStartMs < PAIR_ACCEPT_TIMEOUT_MS)
+            return;
+        if (requestTries >= PAIR_REQUEST_TRIES)
+        {
+            Serial.println("Pairing: Hub did not accept");
+            finish(false, 0);
+            return;
+        }
+        sendRequest();
+    }
+}
@@ -0,0 +1,29 @@
+// File: src/remote/pairing.h
+// Finding and pairing with a Hub instead of a hard-coded MAC.
+// The Hub's MAC and radio channel are kept in NVS, so a normal boot
+// connects straight away; only "pair" (or a first boot) scans the
+// channels for a Hub beacon.
+#pragma once
+
+#include <Arduino.h>
+
+#define PAIR_LISTEN_MS 150 // per channel, the Hub beacons every 100 ms
+#define PAIR_SCAN_PASSES 10
+#define PAIR_ACCEPT_TIMEOUT_MS 500
+#define PAIR_REQUEST_TRIES 3
+
+// Stored Hub, false if this remote was never paired
+bool pairingLoad(uint8_t *mac, uint8_t *channel);
+
+// Starts scanning for a Hub; false if pairing is already under way.
+// pairingPoll() from loop() then does the work without blocking, and
+// saves and connects on success or goes back to the stored Hub.
+bool pairingStart();
+void pairingPoll();
+// The radio is hopping channels or waiting for the Hub's accept
+bool pairingActive();
+
+void pairingForget();
+
+// Called from the receive callback; true if the frame was a pairing one
+bool pairingOnFrame(const uint8_t *mac, const uint8_t *data, int len);
@@ -0,0 +1,253 @@
+// File: src/remote/power.cpp
+#include "power.h"
+#include <esp_now.h>
+#include <esp_wifi.h>
+#include <esp_sleep.h>
+#include <esp_timer.h>
+#include <WiFi.h>
+#include <driver/rtc_io.h>
+#include "protocol.h"
+
+#define RTC_MAGIC 0x52454D31 // "REM1"
+#define BUTTON_DEBOUNCE_MS 30
+
+typedef struct button_def_t
+{
+    uint8_t pin; // RTC-capable GPIO, button to 3V3
+    const char *command;
+} button_def_t;
+
+// --- BUTTONS ---
+static const button_def_t BUTTONS[] = {
+    {32, "TOGGLE_PUMP"},
+    {33, "PUMP_OFF"},
+};
+#define BUTTON_COUNT (sizeof(BUTTONS) / sizeof(BUTTONS[0]))
+
+typedef struct rtc_cache_t
+{
+    uint32_t magic;
+    power_link_t link;
+
+    // Wake statistics since sleep mode was entered
+    uint32_t wakes;
+    uint32_t acked;
+    uint64_t sumTxUs;
+    uint64_t sumAwakeUs;
+    uint64_t sumEnergyUj;
+} rtc_cache_t;
+
+RTC_DATA_ATTR static rtc_cache_t rtc;
+
+static uint8_t buttonLevel[BUTTON_COUNT];
+static uint32_t buttonChangedMs[BUTTON_COUNT];
+
+// Wake path ACK, set from the receive callback
+static volatile bool ackSeen = false;
+static volatile uint8_t ackStatus = 0;
+static volatile int64_t ackUs = 0;
+
+void powerBeginButtons()
+{
+    for (size_t i = 0; i < BUTTON_COUNT; i++)
+    {
+        // The wake-up leaves the pins routed to the RTC mux
+        rtc_gpio_deinit((gpio_num_t)BUTTONS[i].pin);
+        pinMode(BUTTONS[i].pin, INPUT_PULLDOWN);
+        buttonLevel[i] = LOW;
+    }
+}
+
+const char *powerPollButtons()
+{
+    uint32_t now = millis();
+    for (size_t i = 0; i < BUTTON_COUNT; i++)
+    {
+        uint8_t level = digitalRead(BUTTONS[i].pin);
+        if (level == buttonLevel[i] || now - buttonChangedMs[i] < BUTTON_DEBOUNCE_MS)
+            continue;
+        buttonLevel[i] = level;
+        buttonChangedMs[i] = now;
+        if (level == HIGH)
+            return BUTTONS[i].command;
+    }
+    return NULL;
+}
+
+static void onWakeRecv(const uint8_t *mac, const uint8_t *data, int len)
+{
+    if (len != sizeof(ack_message) || data[0] != MSG_ACK || memcmp(mac, rtc.link.hubMac, 6) != 0)
+        return;
+    const ack_message *ack = (const ack_message *)data;
+    if (ack->hdr.session != rtc.link.session || ack->hdr.seq != rtc.link.seq)
+        return;
+    ackStatus = ack->status;
+    ackUs = esp_timer_get_time();
+    ackSeen = true;
+}
+
+static const char *wakeCommand()
+{
+    uint64_t pins = esp_sleep_get_ext1_wakeup_status();
+    for (size_t i = 0; i < BUTTON_COUNT; i++)
+        if (pins & (1ULL << BUTTONS[i].pin))
+            return BUTTONS[i].command;
+    return NULL;
+}
+
+// Waits until every button has read LOW for BUTTON_DEBOUNCE_MS, at most
+// POWER_RELEASE_TIMEOUT_MS. A press longer than the wake path would
+// otherwise wake the remote again at once and send a second command.
+// Returns the wake mask without the buttons still held.
+static uint64_t waitForRelease()
+{
+    for (size_t i = 0; i < BUTTON_COUNT; i++)
+    {
+        gpio_num_t pin = (gpio_num_t)BUTTONS[i].pin;
+        rtc_gpio_init(pin);
+        rtc_gpio_set_direction(pin, RTC_GPIO_MODE_INPUT_ONLY);
+        rtc_gpio_pullup_dis(pin);
+        rtc_gpio_pulldown_en(pin);
+    }
+
+    uint32_t start = millis();
+    uint32_t lowSince = start;
+    uint64_t held = 0;
+    while (millis() - start < POWER_RELEASE_TIMEOUT_MS)
+    {
+        held = 0;
+        for (size_t i = 0; i < BUTTON_COUNT; i++)
+            if (rtc_gpio_get_level((gpio_num_t)BUTTONS[i].pin))
+                held |= 1ULL << BUTTONS[i].pin;
+        if (held != 0)
+            lowSince = millis();
+        else if (millis() - lowSince >= BUTTON_DEBOUNCE_MS)
+            break;
+        delay(1);
+    }
+
+    uint64_t mask = 0;
+    for (size_t i = 0; i < BUTTON_COUNT; i++)
+    {
+        if (held & (1ULL << BUTTONS[i].pin))
+            Serial.printf("GPIO %u still held, it will not wake the remote\n", BUTTONS[i].pin);
+        else
+            mask |= 1ULL << BUTTONS[i].pin;
+    }
+    return mask;
+}
+
+static void armAndSleep()
+{
+    uint64_t mask = waitForRelease();
+    // Keep the RTC pulldowns powered so the lines stay low while asleep
+    esp_sleep_pd_config(ESP_PD_DOMAIN_RTC_PERIPH, ESP_PD_OPTION_ON);
+    if (mask != 0)
+        esp_sleep_enable_ext1_wakeup(mask, ESP_EXT1_WAKEUP_ANY_HIGH);
+    else
+        Serial.println("No button free to wake from, reset to wake");
+    Serial.flush();
+    esp_deep_sleep_start();
+}
+
+void powerHandleWake()
+{
+    if (esp_sleep_get_wakeup_cause() != ESP_SLEEP_WAKEUP_EXT1 || rtc.magic != RTC_MAGIC)
+        return;
+    const char *command = wakeCommand();
+    if (command == NULL)
+        return;
+
+    // Time 0 is app start; ROM and bootloader time before it is not seen
+    int64_t radioUs = esp_timer_get_time();
+    WiFi.mode(WIFI_STA);
+    esp_wifi_set_channel(rtc.link.channel, WIFI_SECOND_CHAN_NONE);
+    if (esp_now_init() != ESP_OK)
+        return;
+    esp_now_register_recv_cb(onWakeRecv);
+    if (rtc.link.hasPmk)
+        esp_now_set_pmk(rtc.link.pmk);
+
+    esp_now_peer_info_t peer;
+    memset(&peer, 0, sizeof(peer));
+    memcpy(peer.peer_addr, rtc.link.hubMac, 6);
+    peer.channel = 0;
+    peer.encrypt = rtc.link.hasLmk;
+    if (peer.encrypt)
+        memcpy(peer.lmk, rtc.link.lmk, KEY_LEN);
+    esp_now_add_peer(&peer);
+
+    struct_message msg;
+    memset(&msg, 0, sizeof(msg));
+    msg.hdr.type = MSG_COMMAND;
+    msg.hdr.version = PROTOCOL_VERSION;
+    msg.hdr.session = rtc.link.session;
+    msg.hdr.seq = ++rtc.link.seq;
+    strncpy(msg.command, command, sizeof(msg.command) - 1);
+
+    // Retries reuse the seq, the Hub answers a repeat with DUPLICATE
+    int64_t txUs = 0;
+    for (int attempt = 0; attempt < POWER_SEND_TRIES && !ackSeen; attempt++)
+    {
+        int64_t sentUs = esp_timer_get_time();
+        if (txUs == 0)
+            txUs = sentUs;
+        esp_now_send(rtc.link.hubMac, (uint8_t *)&msg, sizeof(msg));
+        while (!ackSeen && esp_timer_get_time() - sentUs < POWER_ACK_TIMEOUT_MS * 1000LL)
+            delay(1);
+    }
+
+    int64_t endUs = esp_timer_get_time();
+    esp_wifi_stop();
+
+    // Energy estimate from the two phases, uJ = mA * us * mV / 1000000
+    uint64_t cpuMaUs = (uint64_t)POWER_CPU_MA * radioUs;
+    uint64_t radioMaUs = (uint64_t)POWER_RADIO_MA * (endUs - radioUs);
+    uint64_t energyUj = (cpuMaUs + radioMaUs) * POWER_SUPPLY_MV / 1000000ULL;
+
+    rtc.wakes++;
+    rtc.sumTxUs += txUs;
+    rtc.sumAwakeUs += endUs;
+    rtc.sumEnergyUj += energyUj;
+    if (ackSeen)
+        rtc.acked++;
+
+    Serial.begin(115200);
+    Serial.printf("Wake #%u: %s, tx at %.1f ms, ", (unsigned)rtc.wakes, command, txUs / 1000.0f);
+    if (ackSeen)
+        Serial.printf("ACK status %u at %.1f ms", ackStatus, ackUs / 1000.0f);
+    else
+        Serial.print("no ACK");
+    Serial.printf(", awake %.1f ms, ~%.2f mJ\n", endUs / 1000.0f, energyUj / 1000.0f);
+    powerPrintStats();
+
+    armAndSleep();
+}
+
+void powerSleep(const power_link_t *link)
+{
+    if (rtc.magic != RTC_MAGIC || memcmp(&rtc.link, link, sizeof(*link)) != 0)
+    {
+        memset(&rtc, 0, sizeof(rtc));
+        rtc.link = *link;
+        rtc.magic = RTC_MAGIC;
+    }
+
+    Serial.print("Sleeping, wake with GPIO");
+    for (size_t i = 0; i < BUTTON_COUNT; i++)
+        Serial.printf(" %u (%s)", BUTTONS[i].pin, BUTTONS[i].command);
+    Serial.println(". Reset for the console.");
+    armAndSleep();
+}
+
+void powerPrintStats()
+{
+    if (rtc.magic != RTC_MAGIC || rtc.wakes == 0)
+    {
+        Serial.println("No button wakes yet");
+        return;
+    }
+    Serial.printf("Wakes %u, acked %u, avg wake-to-tx %.1f ms, avg awake %.1f ms, avg ~%.2f mJ/command\n",
+                  (unsigned)rtc.wakes, (unsigned)rtc.acked, rtc.sumTxUs / 1000.0f / rtc.wakes,
+                  rtc.sumAwakeUs / 1000.0f / rtc.wakes, rtc.sumEnergyUj / 1000.0f / rtc.wakes);
+}
@@ -0,0 +1,46 @@
+// File: src/remote/power.h
+// Deep sleep for battery use. Buttons (see BUTTONS in power.cpp) wake
+// the remote; the wake path sends that button's command straight from
+// setup() using the Hub, channel and keys cached in RTC memory, waits
+// for the ACK and sleeps again. Nothing is read from NVS on that path.
+// A reset or power cycle returns to the normal interactive mode.
+#pragma once
+
+#include <Arduino.h>
+#include "key_util.h"
+
+#define POWER_ACK_TIMEOUT_MS 150
+#define POWER_SEND_TRIES 3
+#define POWER_RELEASE_TIMEOUT_MS 3000 // wait for the wake button to be let go
+
+// Rough currents for the energy estimate (ESP32 at 3.3 V)
+#define POWER_SUPPLY_MV 3300
+#define POWER_CPU_MA 40    // booting, radio off
+#define POWER_RADIO_MA 120 // WiFi on, mostly listening for the ACK
+
+// Everything the wake path needs, cached in RTC memory before sleeping
+typedef struct power_link_t
+{
+    uint8_t hubMac[6];
+    uint8_t channel;
+    bool hasPmk;
+    bool hasLmk;
+    uint8_t pmk[KEY_LEN];
+    uint8_t lmk[KEY_LEN];
+    uint32_t session;
+    uint32_t seq;
+} power_link_t;
+
+void powerBeginButtons();
+
+// Command of a button that was just pressed, or NULL. For the awake loop.
+const char *powerPollButtons();
+
+// If this boot is a button wake with a valid cache: send, report and go
+// back to sleep (does not return). Otherwise returns for a normal boot.
+void powerHandleWake();
+
+// Caches link, arms the button wake-up and enters deep sleep
+void powerSleep(const power_link_t *link);
+
+void powerPrintStats();
@@ -0,0 +1,21 @@
+// File: src/remote/remote.h
+// State and helpers main_remote.cpp shares with the other remote modules.
+#pragma once
+
+#include <Arduino.h>
+#include "protocol.h"
+
+extern uint8_t hubMacAddress[];
+extern uint32_t txSession;
+extern uint32_t txSeq; // last seq used in this session
+
+bool hubPaired();
+// (Re)registers the Hub as the ESP-NOW peer on channel. encrypt uses the
+// stored LMK if there is one.
+bool connectHub(const uint8_t *mac, uint8_t channel, bool encrypt);
+
+// Fills in a header with the next seq of this session
+void stampHeader(msg_header_t *hdr, uint8_t type);
+
+bool hubKeyInstalled();
+bool setHubEncryption(bool encrypt);
@@ -0,0 +1,301 @@
+// File: src/remote/send_queue.cpp
+#include "send_queue.h"
+#include <esp_now.h>
+#include "remote.h"
+
+typedef enum
+{
+    SQ_FREE,
+    SQ_WAITING,   // due for (re)transmission at dueMs
+    SQ_ON_AIR,    // sent, waiting for the send callback
+    SQ_AWAIT_ACK, // delivered, waiting for the Hub's ACK until dueMs
+} sq_state_t;
+
+typedef struct sq_entry_t
+{
+    uint8_t state;
+    uint8_t tries;
+    uint16_t len;
+    uint32_t seq;
+    uint32_t order; // push order, older entries go first
+    uint32_t dueMs;
+    uint32_t runMs;
+    send_done_cb done;
+    uint8_t frame[SENDQ_MAX_LEN];
+} sq_entry_t;
+
+#define MAC_NONE 0
+#define MAC_DELIVERED 1
+#define MAC_FAILED 2
+
+static sq_entry_t entries[SENDQ_DEPTH];
+static uint32_t nextOrder = 0;
+static int onAir = -1; // entry waiting for the send callback
+static uint32_t onAirMs = 0;
+static volatile bool macExpected = false;
+static volatile uint8_t macResult = MAC_NONE;
+
+// Send numbering: the n-th successful esp_now_send gets the n-th callback
+static portMUX_TYPE sentLock = portMUX_INITIALIZER_UNLOCKED;
+static uint32_t sendsStarted = 0;
+static uint32_t sendsReported = 0;
+static volatile uint32_t onAirTicket = 0;
+static uint32_t foreignCallbacks = 0; // callbacks of sends the queue did not make
+
+// Statistics
+static uint32_t pushed = 0;
+static uint32_t acked = 0;
+static uint32_t failed = 0;
+static uint32_t retries = 0;
+static uint32_t macFails = 0;
+static uint32_t ackTimeouts = 0;
+static uint32_t rejected = 0;
+
+void sendQueueBegin()
+{
+    memset(entries, 0, sizeof(entries));
+    onAir = -1;
+    macExpected = false;
+    sendsStarted = sendsReported = 0;
+}
+
+// All sends run on the loop task; the callback may come before
+// esp_now_send() returns, so the number is taken first
+static esp_err_t numberedSend(const uint8_t *mac, const uint8_t *data, size_t len, volatile uint32_t *ticket)
+{
+    portENTER_CRITICAL(&sentLock);
+    uint32_t n = sendsStarted++;
+    portEXIT_CRITICAL(&sentLock);
+    if (ticket != NULL)
+        *ticket = n;
+
+    esp_err_t err = esp_now_send(mac, data, len);
+    if (err != ESP_OK)
+    {
+        portENTER_CRITICAL(&sentLock);
+        sendsStarted--; // no callback will come
+        portEXIT_CRITICAL(&sentLock);
+    }
+    return err;
+}
+
+esp_err_t sendQueueSendDirect(const uint8_t *mac, const uint8_t *data, size_t len)
+{
+    return numberedSend(mac, data, len, NULL);
+}
+
+static int freeSlot()
+{
+    for (int i = 0; i < SENDQ_DEPTH; i++)
+        if (entries[i].state == SQ_FREE)
+            return i;
+    return -1;
+}
+
+bool sendQueueFull()
+{
+    return freeSlot() < 0;
+}
+
+size_t sendQueuePending()
+{
+    size_t n = 0;
+    for (int i = 0; i < SENDQ_DEPTH; i++)
+        if (entries[i].state != SQ_FREE)
+            n++;
+    return n;
+}
+
+bool sendQueuePush(const void *frame, size_t len, uint32_t runMs, send_done_cb done)
+{
+    int slot = freeSlot();
+    if (slot < 0 || len < sizeof(msg_header_t) || len > SENDQ_MAX_LEN)
+    {
+        rejected++;
+        return false;
+    }
+
+    sq_entry_t *e = &entries[slot];
+    memcpy(e->frame, frame, len);
+    e->len = (uint16_t)len;
+    e->seq = ((const msg_header_t *)frame)->seq;
+    e->tries = 0;
+    e->order = nextOrder++;
+    e->dueMs = millis();
+    e->runMs = runMs;
+    e->done = done;
+    e->state = SQ_WAITING;
+    pushed++;
+
+    sendQueuePoll(); // an idle queue sends right away
+    return true;
+}
+
+static void finish(sq_entry_t *e, send_result_t result)
+{
+    if (onAir == e - entries)
+    {
+        onAir = -1;
+        macExpected = false;
+    }
+    e->state = SQ_FREE;
+    if (result == SEND_ACKED)
+        acked++;
+    else if (result == SEND_FAILED)
+        failed++;
+    if (e->done != NULL)
+        e->done(e->seq, result, e->tries);
+}
+
+void sendQueueFlush()
+{
+    for (int i = 0; i < SENDQ_DEPTH; i++)
+        if (entries[i].state != SQ_FREE)
+            finish(&entries[i], SEND_FLUSHED);
+}
+
+void sendQueueOnSent(const uint8_t *mac, bool delivered)
+{
+    portENTER_CRITICAL(&sentLock);
+    // With nothing outstanding it is the late callback of a send the
+    // queue already gave up on (the count was resynchronised)
+    if (sendsReported != sendsStarted)
+    {
+        uint32_t n = sendsReported++;
+        if (macExpected && n == onAirTicket && mac != NULL && memcmp(mac, hubMacAddress, 6) == 0)
+        {
+            macResult = delivered ? MAC_DELIVERED : MAC_FAILED;
+            macExpected = false;
+        }
+        else
+        {
+            foreignCallbacks++;
+        }
+    }
+    portEXIT_CRITICAL(&sentLock);
+}
+
+void sendQueueOnAck(uint32_t seq)
+{
+    for (int i = 0; i < SENDQ_DEPTH; i++)
+        if (entries[i].state != SQ_FREE && entries[i].seq == seq)
+            finish(&entries[i], SEND_ACKED);
+}
+
+// Full jitter over the upper half: spreads retries from several remotes
+// without ever retrying sooner than half the nominal backoff
+static uint32_t backoffMs(uint8_t tries)
+{
+    uint32_t ms = SENDQ_BACKOFF_BASE_MS << min((uint8_t)(tries - 1), (uint8_t)6);
+    if (ms > SENDQ_BACKOFF_MAX_MS)
+        ms = SENDQ_BACKOFF_MAX_MS;
+    return ms / 2 + esp_random() % (ms / 2 + 1);
+}
+
+static void retry(sq_entry_t *e, const char *reason)
+{
+    if (onAir == e - entries)
+        onAir = -1;
+    if (e->tries >= SENDQ_TRIES)
+    {
+        finish(e, SEND_FAILED);
+        return;
+    }
+    uint32_t wait = backoffMs(e->tries);
+    e->state = SQ_WAITING;
+    e->dueMs = millis() + wait;
+    retries++;
+    Serial.printf("Seq %u: %s, retry %u/%u in %u ms\n", (unsigned)e->seq, reason, e->tries,
+                  SENDQ_TRIES - 1, (unsigned)wait);
+}
+
+void sendQueuePoll()
+{
+    uint32_t now = millis();
+
+    // Outcome of the frame on the air
+    if (onAir >= 0)
+    {
+        sq_entry_t *e = &entries[onAir];
+        uint8_t result = macResult;
+        if (result == MAC_DELIVERED)
+        {
+            onAir = -1;
+            if (e->state == SQ_ON_AIR)
+            {
+                e->state = SQ_AWAIT_ACK;
+                e->dueMs = now + e->runMs + SENDQ_ACK_TIMEOUT_MS;
+            }
+        }
+        else if (result == MAC_FAILED || now - onAirMs >= SENDQ_MAC_TIMEOUT_MS)
+        {
+            macExpected = false;
+            if (result != MAC_FAILED)
+            {
+                // A callback went missing: count from here on afresh
+                portENTER_CRITICAL(&sentLock);
+                sendsReported = sendsStarted;
+                portEXIT_CRITICAL(&sentLock);
+            }
+            macFails++;
+            retry(e, "delivery failed");
+        }
+    }
+
+    // ACK deadlines
+    for (int i = 0; i < SENDQ_DEPTH; i++)
+    {
+        sq_entry_t *e = &entries[i];
+        if (e->state == SQ_AWAIT_ACK && (int32_t)(now - e->dueMs) >= 0)
+        {
+            ackTimeouts++;
+            retry(e, "no ACK");
+        }
+    }
+
+    if (onAir >= 0 || !hubPaired())
+        return;
+
+    // Oldest due entry goes on the air next
+    sq_entry_t *next = NULL;
+    for (int i = 0; i < SENDQ_DEPTH; i++)
+    {
+        sq_entry_t *e = &entries[i];
+        if (e->state == SQ_WAITING && (int32_t)(now - e->dueMs) >= 0 &&
+            (next == NULL || (int32_t)(e->order - next->order) < 0))
+            next = e;
+    }
+    if (next == NULL)
+        return;
+
+    next->tries++;
+    next->state = SQ_ON_AIR;
+    onAir = next - entries;
+    onAirMs = now;
+    macResult = MAC_NONE;
+    macExpected = true;
+    if (numberedSend(hubMacAddress, next->frame, next->len, &onAirTicket) != ESP_OK)
+    {
+        // TX buffer full or peer gone: counts as a failed attempt
+        macExpected = false;
+        macFails++;
+        retry(next, "send error");
+    }
+}
+
+void sendQueuePrint(Print &out)
+{
+    out.printf("Send queue: %u/%u pending, %u pushed, %u acked, %u failed, %u rejected\n",
+               (unsigned)sendQueuePending(), SENDQ_DEPTH, (unsigned)pushed, (unsigned)acked,
+               (unsigned)failed, (unsigned)rejected);
+    out.printf("  %u retries (%u delivery failures, %u ACK timeouts), %u send callbacks not ours\n",
+               (unsigned)retries, (unsigned)macFails, (unsigned)ackTimeouts, (unsigned)foreignCallbacks);
+    for (int i = 0; i < SENDQ_DEPTH; i++)
+    {
+        const sq_entry_t *e = &entries[i];
+        if (e->state == SQ_FREE)
+            continue;
+        static const char *const names[] = {"free", "waiting", "on air", "awaiting ACK"};
+        out.printf("  seq %u: %s, try %u/%u\n", (unsigned)e->seq, names[e->state], e->tries, SENDQ_TRIES);
+    }
+}
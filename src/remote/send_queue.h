@@ -0,0 +1,55 @@
+// File: src/remote/send_queue.h
+// Outgoing frames to the Hub with retries. Each entry is retransmitted
+// (same seq, so the Hub answers a repeat with DUPLICATE instead of running
+// it twice) when the MAC reports a delivery failure or no ACK comes back,
+// waiting a jittered exponential backoff in between. Several entries may
+// wait for their ACK at once; only one is on the air at a time because
+// the send callback does not say which frame it belongs to. Callbacks come
+// back in send order, so every send is numbered and the queue takes only
+// the callback of its own; frames sent around the queue (bench, pairing)
+// must go out through sendQueueSendDirect() for that count to hold.
+#pragma once
+
+#include <Arduino.h>
+#include "protocol.h"
+
+#define SENDQ_DEPTH 8
+#define SENDQ_MAX_LEN sizeof(batch_message)
+#define SENDQ_TRIES 5               // first send included
+#define SENDQ_BACKOFF_BASE_MS 20    // doubled per retry
+#define SENDQ_BACKOFF_MAX_MS 1000
+#define SENDQ_MAC_TIMEOUT_MS 100    // no send callback by then counts as a failure
+#define SENDQ_ACK_TIMEOUT_MS 250
+
+typedef enum
+{
+    SEND_ACKED,   // the Hub answered
+    SEND_FAILED,  // retries used up
+    SEND_FLUSHED, // dropped by sendQueueFlush()
+} send_result_t;
+
+// Called from sendQueuePoll()/sendQueueOnAck(), i.e. from loop()
+typedef void (*send_done_cb)(uint32_t seq, send_result_t result, uint8_t tries);
+
+void sendQueueBegin();
+
+// frame must start with a stamped msg_header_t. runMs is how long the Hub
+// needs before it answers (the waits of a batch), added to the ACK
+// timeout. False if the queue is full.
+bool sendQueuePush(const void *frame, size_t len, uint32_t runMs, send_done_cb done);
+bool sendQueueFull();
+size_t sendQueuePending();
+void sendQueueFlush();
+
+// esp_now_send() for frames that do not go through the queue
+esp_err_t sendQueueSendDirect(const uint8_t *mac, const uint8_t *data, size_t len);
+
+// From the send callback (WiFi task)
+void sendQueueOnSent(const uint8_t *mac, bool delivered);
+// From loop() for every ACK or batch ACK of our session
+void sendQueueOnAck(uint32_t seq);
+
+// Transmits, times out and retries, from loop()
+void sendQueuePoll();
+
+void sendQueuePrint(Print &out);
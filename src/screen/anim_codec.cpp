@@ -0,0 +1,323 @@
+// File: src/screen/anim_codec.cpp
+#include "anim_codec.h"
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef ARDUINO
+#include <esp_heap_caps.h>
+#include <esp_timer.h>
+#else
+#include <time.h>
+#endif
+
+// The one decoded frame. LVGL draws straight from it, so it stays valid
+// until another frame is opened.
+static uint16_t *frameBuf = NULL;
+static uint32_t frameBufPixels = 0;
+static const anim_clip_t *bufClip = NULL;
+static int32_t bufIndex = -1;
+
+static anim_codec_stats_t stats;
+
+// animCodecShow() swaps the source of an image behind LVGL's back, and
+// every frame is decoded into the same frameBuf. A cached decoded frame
+// would be drawn stale, so the image cache has to stay at LVGL's default
+// of none.
+static_assert(LV_IMG_CACHE_DEF_SIZE == 0, "anim_codec.cpp needs LVGL's image cache off");
+
+static uint64_t nowUs()
+{
+#ifdef ARDUINO
+    return (uint64_t)esp_timer_get_time();
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000ULL + ts.tv_nsec / 1000;
+#endif
+}
+
+static bool ensureBuffer(uint32_t pixels)
+{
+    if (frameBufPixels >= pixels)
+        return true;
+#ifdef ARDUINO
+    // 260 KB for the boot animation, too much for internal RAM
+    void *buf = heap_caps_malloc(pixels * sizeof(uint16_t), MALLOC_CAP_SPIRAM);
+    heap_caps_free(frameBuf);
+#else
+    void *buf = malloc(pixels * sizeof(uint16_t));
+    free(frameBuf);
+#endif
+    frameBuf = (uint16_t *)buf;
+    frameBufPixels = buf != NULL ? pixels : 0;
+    bufClip = NULL;
+    bufIndex = -1;
+    return buf != NULL;
+}
+
+static uint32_t tilesAcross(const anim_clip_t *clip)
+{
+    return (clip->w + ANIM_TILE - 1) / ANIM_TILE;
+}
+
+static uint32_t tileCount(const anim_clip_t *clip)
+{
+    return tilesAcross(clip) * ((clip->h + ANIM_TILE - 1) / ANIM_TILE);
+}
+
+static const uint16_t *tileMap(const anim_clip_t *clip, uint16_t index)
+{
+    return (const uint16_t *)assetsData(clip->entries[index]);
+}
+
+// Decodes one tile stream. False if it is corrupt.
+static bool decodeTile(const uint8_t *p, const uint8_t *end, uint16_t *out)
+{
+    uint16_t *outEnd = out + ANIM_TILE * ANIM_TILE;
+    // Every read is checked against end first: a bad stream fails the
+    // tile instead of reading past it
+    while (p < end)
+    {
+        uint8_t op = *p >> 6;
+        uint32_t n = *p++ & 0x3F;
+        if (n == 0)
+        {
+            if (end - p < 2)
+                return false;
+            n = p[0] | (p[1] << 8);
+            p += 2;
+        }
+        if (n > (uint32_t)(outEnd - out))
+            return false;
+
+        switch (op)
+        {
+        case ANIM_OP_RUN:
+        {
+            if (end - p < 2)
+                return false;
+            uint16_t colour = p[0] | (p[1] << 8);
+            p += 2;
+            for (uint32_t i = 0; i < n; i++)
+                out[i] = colour;
+            break;
+        }
+        case ANIM_OP_COPY:
+            if ((uint32_t)(end - p) < n * sizeof(uint16_t))
+                return false;
+            memcpy(out, p, n * sizeof(uint16_t));
+            p += n * sizeof(uint16_t);
+            break;
+        default:
+            return false;
+        }
+        out += n;
+    }
+    return p == end && out == outEnd;
+}
+
+// Tile id of the store into the frame buffer at tile t, clipped to the
+// frame. False if the id or its stream is bad.
+static bool blitTile(const anim_clip_t *clip, uint16_t id, uint32_t t)
+{
+    static uint16_t tile[ANIM_TILE * ANIM_TILE]; // only the LVGL task decodes
+
+    const uint8_t *store = assetsData(clip->tiles);
+    uint32_t count, from, to;
+    memcpy(&count, store, sizeof(count));
+    if (id >= count)
+        return false;
+    memcpy(&from, store + 4 + 4 * id, sizeof(from));
+    memcpy(&to, store + 8 + 4 * id, sizeof(to));
+    if (from > to || to > clip->tiles->size || !decodeTile(store + from, store + to, tile))
+        return false;
+
+    uint32_t x = (t % tilesAcross(clip)) * ANIM_TILE;
+    uint32_t y = (t / tilesAcross(clip)) * ANIM_TILE;
+    uint32_t w = clip->w - x < ANIM_TILE ? clip->w - x : ANIM_TILE;
+    uint32_t h = clip->h - y < ANIM_TILE ? clip->h - y : ANIM_TILE;
+    for (uint32_t row = 0; row < h; row++)
+        memcpy(frameBuf + (y + row) * clip->w + x, tile + row * ANIM_TILE, w * sizeof(uint16_t));
+    return true;
+}
+
+static bool decodeFrame(const anim_clip_t *clip, uint16_t index)
+{
+    if (bufClip == clip && bufIndex == index)
+        return true;
+
+    uint32_t pixels = (uint32_t)clip->w * clip->h;
+    if (!clip->bound || index >= clip->count || !ensureBuffer(pixels))
+        return false;
+
+    // Only the tiles that differ from the frame already in the buffer
+    uint64_t start = nowUs();
+    const uint16_t *map = tileMap(clip, index);
+    const uint16_t *prev = (bufClip == clip && bufIndex >= 0) ? tileMap(clip, bufIndex) : NULL;
+    uint32_t tiles = tileCount(clip);
+
+    bufClip = NULL; // half-built until the loop is done
+    for (uint32_t t = 0; t < tiles; t++)
+    {
+        if (prev != NULL && prev[t] == map[t])
+            continue;
+        if (!blitTile(clip, map[t], t))
+        {
+            stats.errors++;
+            return false;
+        }
+        stats.tiles++;
+    }
+    bufClip = clip;
+    bufIndex = index;
+
+    uint32_t us = nowUs() - start;
+    stats.frames++;
+    stats.decodeUs += us;
+    if (us > stats.maxUs)
+        stats.maxUs = us;
+    return true;
+}
+
+static const anim_frame_t *frameOf(const void *src)
+{
+    if (lv_img_src_get_type(src) != LV_IMG_SRC_VARIABLE)
+        return NULL;
+    const lv_img_dsc_t *img = (const lv_img_dsc_t *)src;
+    if (img->header.cf != LV_IMG_CF_USER_ENCODED_0 || img->data_size != sizeof(anim_frame_t))
+        return NULL;
+    const anim_frame_t *frame = (const anim_frame_t *)img->data;
+    return frame->magic == ANIM_FRAME_MAGIC ? frame : NULL;
+}
+
+static lv_res_t infoCb(lv_img_decoder_t *decoder, const void *src, lv_img_header_t *header)
+{
+    if (frameOf(src) == NULL)
+        return LV_RES_INV;
+    *header = ((const lv_img_dsc_t *)src)->header;
+    return LV_RES_OK;
+}
+
+static lv_res_t openCb(lv_img_decoder_t *decoder, lv_img_decoder_dsc_t *dsc)
+{
+    const anim_frame_t *frame = frameOf(dsc->src);
+    if (frame == NULL)
+        return LV_RES_INV;
+
+    stats.opens++;
+    if (!decodeFrame(frame->clip, frame->index))
+        return LV_RES_INV;
+    dsc->header.cf = LV_IMG_CF_TRUE_COLOR;
+    dsc->img_data = (const uint8_t *)frameBuf;
+    return LV_RES_OK;
+}
+
+static void closeCb(lv_img_decoder_t *decoder, lv_img_decoder_dsc_t *dsc)
+{
+    // frameBuf is kept for the next frame
+}
+
+// The tile store and every tile map have to be in the pack with the
+// sizes the app expects
+static bool bindClip(anim_clip_t *clip)
+{
+    clip->bound = false;
+    clip->tiles = assetsFind(clip->tilesName);
+    if (clip->tiles == NULL || !(clip->tiles->flags & ASSET_FLAG_TILES) || clip->tiles->w != ANIM_TILE ||
+        clip->tiles->h != ANIM_TILE || clip->tiles->size < 8)
+        return false;
+    uint32_t count;
+    memcpy(&count, assetsData(clip->tiles), sizeof(count));
+    if (count > 0xFFFF || 8 + 4 * count > clip->tiles->size)
+        return false;
+    for (uint16_t i = 0; i < clip->count; i++)
+    {
+        const asset_entry_t *entry = assetsFind(clip->names[i]);
+        if (entry == NULL || entry->cf != LV_IMG_CF_USER_ENCODED_0 || entry->w != clip->w || entry->h != clip->h ||
+            entry->size != tileCount(clip) * sizeof(uint16_t))
+            return false;
+        clip->entries[i] = entry;
+    }
+    clip->bound = true;
+    return true;
+}
+
+// LVGL draws the image from the top left of the object's content area;
+// anything else cannot be invalidated tile by tile
+static bool drawnOneToOne(lv_obj_t *img, const anim_clip_t *clip)
+{
+    return lv_img_get_zoom(img) == LV_IMG_ZOOM_NONE && lv_img_get_angle(img) == 0 && lv_img_get_offset_x(img) == 0 &&
+           lv_img_get_offset_y(img) == 0 && lv_obj_get_content_width(img) == clip->w &&
+           lv_obj_get_content_height(img) == clip->h;
+}
+
+bool animCodecShow(lv_obj_t *img, const lv_img_dsc_t *next)
+{
+    const anim_frame_t *from = frameOf(lv_img_get_src(img));
+    const anim_frame_t *to = frameOf(next);
+    if (from == NULL || to == NULL || from->clip != to->clip || !to->clip->bound || !drawnOneToOne(img, to->clip))
+    {
+        lv_img_set_src(img, next);
+        return false;
+    }
+    if (from == to)
+        return true;
+
+    // One area per tile row, from its first to its last changed tile, so
+    // a frame never needs more areas than LVGL keeps (LV_INV_BUF_SIZE)
+    const anim_clip_t *clip = to->clip;
+    const uint16_t *a = tileMap(clip, from->index);
+    const uint16_t *b = tileMap(clip, to->index);
+    uint32_t across = tilesAcross(clip);
+    lv_area_t content;
+    lv_obj_get_content_coords(img, &content);
+    for (uint32_t t = 0; t < tileCount(clip); t += across)
+    {
+        int32_t first = -1, last = -1;
+        for (uint32_t i = 0; i < across; i++)
+            if (a[t + i] != b[t + i])
+            {
+                if (first < 0)
+                    first = i;
+                last = i;
+            }
+        if (first < 0)
+            continue;
+
+        lv_area_t area;
+        area.x1 = content.x1 + first * ANIM_TILE;
+        area.y1 = content.y1 + (t / across) * ANIM_TILE;
+        area.x2 = LV_MIN(content.x1 + (last + 1) * ANIM_TILE, content.x1 + clip->w) - 1;
+        area.y2 = LV_MIN(area.y1 + ANIM_TILE, content.y1 + clip->h) - 1;
+        lv_obj_invalidate_area(img, &area);
+        stats.shownPx += lv_area_get_size(&area);
+    }
+    stats.shows++;
+
+    // lv_img_set_src() would invalidate the whole image. Both frames have
+    // the same size and format, so only the source pointer changes. This
+    // bypasses LVGL's image cache, which is off (see the assert above).
+    ((lv_img_t *)img)->src = next;
+    return true;
+}
+
+bool animCodecBegin(void)
+{
+    lv_img_decoder_t *decoder = lv_img_decoder_create();
+    lv_img_decoder_set_info_cb(decoder, infoCb);
+    lv_img_decoder_set_open_cb(decoder, openCb);
+    lv_img_decoder_set_close_cb(decoder, closeCb);
+
+    bool ok = true;
+    for (uint16_t i = 0; i < anim_clip_count; i++)
+        ok &= bindClip(anim_clips[i]);
+    bufClip = NULL;
+    bufIndex = -1;
+    return ok;
+}
+
+void animCodecTakeStats(anim_codec_stats_t *out)
+{
+    *out = stats;
+    memset(&stats, 0, sizeof(stats));
+}
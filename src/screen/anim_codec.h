@@ -0,0 +1,79 @@
+// File: src/screen/anim_codec.h
+// Tiled animation frames. tools/pack_assets.py cuts the SquareLine image
+// sets into 16x16 tiles, stores every distinct tile once in the asset
+// partition and each frame as a map of tile ids, and generates
+// anim_frames.c, where every frame is an lv_img_dsc_t with cf
+// LV_IMG_CF_USER_ENCODED_0 whose data points to an anim_frame_t. The
+// LVGL decoder registered by animCodecBegin() builds frames in one
+// shared RGB565 buffer, blitting only the tiles that differ from the
+// frame already in it, and animCodecShow() invalidates only those.
+// The formats are described in tools/anim_codec.py.
+#pragma once
+
+#include <lvgl.h>
+#include "assets.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define ANIM_FRAME_MAGIC 0x314D4E41 // "ANM1"
+
+#define ANIM_TILE 16
+#define ANIM_OP_RUN 1
+#define ANIM_OP_COPY 2
+
+// Frame names are fixed at build time; the tile maps and the tile store
+// are looked up in the asset pack by animCodecBegin()
+typedef struct anim_clip_t
+{
+    uint16_t w;
+    uint16_t h;
+    uint16_t count;
+    const char *const *names;
+    const asset_entry_t **entries;
+    const char *tilesName;
+    const asset_entry_t *tiles;
+    bool bound; // the tiles and every frame were found in the pack
+} anim_clip_t;
+
+typedef struct anim_frame_t
+{
+    uint32_t magic;
+    const anim_clip_t *clip;
+    uint16_t index;
+} anim_frame_t;
+
+typedef struct anim_codec_stats_t
+{
+    uint32_t opens;   // decoder opens, LVGL opens once per draw
+    uint32_t frames;  // frames that had to be rebuilt
+    uint32_t tiles;   // tiles blitted for them
+    uint32_t shows;   // frame changes that invalidated only changed tiles
+    uint64_t shownPx; // pixels those invalidated
+    uint64_t decodeUs;
+    uint32_t maxUs;
+    uint32_t errors;
+} anim_codec_stats_t;
+
+// From anim_frames.c
+extern anim_clip_t *const anim_clips[];
+extern const uint16_t anim_clip_count;
+
+// Registers the decoder and binds the clips to the asset pack opened
+// before. Call after lv_init() and before ui_init(). False if a clip
+// could not be bound; its frames then draw as nothing.
+bool animCodecBegin(void);
+
+// Shows next on img, which must be showing a frame of the same clip, by
+// invalidating only the tiles that differ. Anything else, or an image
+// that is zoomed, rotated or not sized to the frame, falls back to
+// lv_img_set_src(). False if it fell back.
+bool animCodecShow(lv_obj_t *img, const lv_img_dsc_t *next);
+
+// Counters since the last call, then resets
+void animCodecTakeStats(anim_codec_stats_t *out);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,380 @@
+// File: src/screen/anim_frames.c
+// Generated by tools/pack_assets.py from src/screen/ui, do not edit.
+// The descriptors keep SquareLine's names so the image sets in ui.c
+// link against these instead of the raw ui_img_<number>.c arrays.
+// The tile maps and tiles are in the asset partition, found by name.
+#include "anim_codec.h"
+
+// --- ui_imgset_2088225200 ---
+static const char *const anim_2088225200_names[] = {
+    "ui_img_1255442560",
+    "ui_img_881007481",
+    "ui_img_554368748",
+    "ui_img_1282450877",
+    "ui_img_200721698",
+    "ui_img_1303013389",
+    "ui_img_132362840",
+    "ui_img_1604149530",
+    "ui_img_1255441537",
+    "ui_img_527359408",
+    "ui_img_1609088587",
+    "ui_img_881006458",
+    "ui_img_554369771",
+    "ui_img_1282451900",
+    "ui_img_200722721",
+    "ui_img_1303012366",
+    "ui_img_132363863",
+    "ui_img_1604146457",
+    "ui_img_1255444610",
+    "ui_img_527362481",
+    "ui_img_1609091660",
+    "ui_img_881009531",
+    "ui_img_554366698",
+    "ui_img_1282448827",
+    "ui_img_200719648",
+    "ui_img_1303015439",
+    "ui_img_132360790",
+    "ui_img_1604147480",
+    "ui_img_1255443587",
+    "ui_img_527361458",
+    "ui_img_1609090637",
+    "ui_img_881008508",
+    "ui_img_554367721",
+    "ui_img_1282449850",
+    "ui_img_200720671",
+    "ui_img_1303014416",
+};
+static const asset_entry_t *anim_2088225200_entries[36];
+anim_clip_t anim_2088225200 = {480, 270, 36, anim_2088225200_names, anim_2088225200_entries, "tiles_2088225200", NULL, false};
+static const anim_frame_t anim_2088225200_frames[] = {
+    {ANIM_FRAME_MAGIC, &anim_2088225200, 0},
+    {ANIM_FRAME_MAGIC, &anim_2088225200, 1},
+    {ANIM_FRAME_MAGIC, &anim_2088225200, 2},
+    {ANIM_FRAME_MAGIC, &anim_2088225200, 3},
+    {ANIM_FRAME_MAGIC, &anim_2088225200, 4},
+    {ANIM_FRAME_MAGIC, &anim_2088225200, 5},
+    {ANIM_FRAME_MAGIC, &anim_2088225200, 6},
+    {ANIM_FRAME_MAGIC, &anim_2088225200, 7},
+    {ANIM_FRAME_MAGIC, &anim_2088225200, 8},
+    {ANIM_FRAME_MAGIC, &anim_2088225200, 9},
+    {ANIM_FRAME_MAGIC, &anim_2088225200, 10},
+    {ANIM_FRAME_MAGIC, &anim_2088225200, 11},
+    {ANIM_FRAME_MAGIC, &anim_2088225200, 12},
+    {ANIM_FRAME_MAGIC, &anim_2088225200, 13},
+    {ANIM_FRAME_MAGIC, &anim_2088225200, 14},
+    {ANIM_FRAME_MAGIC, &anim_2088225200, 15},
+    {ANIM_FRAME_MAGIC, &anim_2088225200, 16},
+    {ANIM_FRAME_MAGIC, &anim_2088225200, 17},
+    {ANIM_FRAME_MAGIC, &anim_2088225200, 18},
+    {ANIM_FRAME_MAGIC, &anim_2088225200, 19},
+    {ANIM_FRAME_MAGIC, &anim_2088225200, 20},
+    {ANIM_FRAME_MAGIC, &anim_2088225200, 21},
+    {ANIM_FRAME_MAGIC, &anim_2088225200, 22},
+    {ANIM_FRAME_MAGIC, &anim_2088225200, 23},
+    {ANIM_FRAME_MAGIC, &anim_2088225200, 24},
+    {ANIM_FRAME_MAGIC, &anim_2088225200, 25},
+    {ANIM_FRAME_MAGIC, &anim_2088225200, 26},
+    {ANIM_FRAME_MAGIC, &anim_2088225200, 27},
+    {ANIM_FRAME_MAGIC, &anim_2088225200, 28},
+    {ANIM_FRAME_MAGIC, &anim_2088225200, 29},
+    {ANIM_FRAME_MAGIC, &anim_2088225200, 30},
+    {ANIM_FRAME_MAGIC, &anim_2088225200, 31},
+    {ANIM_FRAME_MAGIC, &anim_2088225200, 32},
+    {ANIM_FRAME_MAGIC, &anim_2088225200, 33},
+    {ANIM_FRAME_MAGIC, &anim_2088225200, 34},
+    {ANIM_FRAME_MAGIC, &anim_2088225200, 35},
+};
+
+const lv_img_dsc_t ui_img_1255442560 = {
+    .header.always_zero = 0,
+    .header.w = 480,
+    .header.h = 270,
+    .data_size = sizeof(anim_frame_t),
+    .header.cf = LV_IMG_CF_USER_ENCODED_0,
+    .data = (const uint8_t *)&anim_2088225200_frames[0],
+};
+const lv_img_dsc_t ui_img_881007481 = {
+    .header.always_zero = 0,
+    .header.w = 480,
+    .header.h = 270,
+    .data_size = sizeof(anim_frame_t),
+    .header.cf = LV_IMG_CF_USER_ENCODED_0,
+    .data = (const uint8_t *)&anim_2088225200_frames[1],
+};
+const lv_img_dsc_t ui_img_554368748 = {
+    .header.always_zero = 0,
+    .header.w = 480,
+    .header.h = 270,
+    .data_size = sizeof(anim_frame_t),
+    .header.cf = LV_IMG_CF_USER_ENCODED_0,
+    .data = (const uint8_t *)&anim_2088225200_frames[2],
+};
+const lv_img_dsc_t ui_img_1282450877 = {
+    .header.always_zero = 0,
+    .header.w = 480,
+    .header.h = 270,
+    .data_size = sizeof(anim_frame_t),
+    .header.cf = LV_IMG_CF_USER_ENCODED_0,
+    .data = (const uint8_t *)&anim_2088225200_frames[3],
+};
+const lv_img_dsc_t ui_img_200721698 = {
+    .header.always_zero = 0,
+    .header.w = 480,
+    .header.h = 270,
+    .data_size = sizeof(anim_frame_t),
+    .header.cf = LV_IMG_CF_USER_ENCODED_0,
+    .data = (const uint8_t *)&anim_2088225200_frames[4],
+};
+const lv_img_dsc_t ui_img_1303013389 = {
+    .header.always_zero = 0,
+    .header.w = 480,
+    .header.h = 270,
+    .data_size = sizeof(anim_frame_t),
+    .header.cf = LV_IMG_CF_USER_ENCODED_0,
+    .data = (const uint8_t *)&anim_2088225200_frames[5],
+};
+const lv_img_dsc_t ui_img_132362840 = {
+    .header.always_zero = 0,
+    .header.w = 480,
+    .header.h = 270,
+    .data_size = sizeof(anim_frame_t),
+    .header.cf = LV_IMG_CF_USER_ENCODED_0,
+    .data = (const uint8_t *)&anim_2088225200_frames[6],
+};
+const lv_img_dsc_t ui_img_1604149530 = {
+    .header.always_zero = 0,
+    .header.w = 480,
+    .header.h = 270,
+    .data_size = sizeof(anim_frame_t),
+    .header.cf = LV_IMG_CF_USER_ENCODED_0,
+    .data = (const uint8_t *)&anim_2088225200_frames[7],
+};
+const lv_img_dsc_t ui_img_1255441537 = {
+    .header.always_zero = 0,
+    .header.w = 480,
+    .header.h = 270,
+    .data_size = sizeof(anim_frame_t),
+    .header.cf = LV_IMG_CF_USER_ENCODED_0,
+    .data = (const uint8_t *)&anim_2088225200_frames[8],
+};
+const lv_img_dsc_t ui_img_527359408 = {
+    .header.always_zero = 0,
+    .header.w = 480,
+    .header.h = 270,
+    .data_size = sizeof(anim_frame_t),
+    .header.cf = LV_IMG_CF_USER_ENCODED_0,
+    .data = (const uint8_t *)&anim_2088225200_frames[9],
+};
+const lv_img_dsc_t ui_img_1609088587 = {
+    .header.always_zero = 0,
+    .header.w = 480,
+    .header.h = 270,
+    .data_size = sizeof(anim_frame_t),
+    .header.cf = LV_IMG_CF_USER_ENCODED_0,
+    .data = (const uint8_t *)&anim_2088225200_frames[10],
+};
+const lv_img_dsc_t ui_img_881006458 = {
+    .header.always_zero = 0,
+    .header.w = 480,
+    .header.h = 270,
+    .data_size = sizeof(anim_frame_t),
+    .header.cf = LV_IMG_CF_USER_ENCODED_0,
+    .data = (const uint8_t *)&anim_2088225200_frames[11],
+};
+const lv_img_dsc_t ui_img_554369771 = {
+    .header.always_zero = 0,
+    .header.w = 480,
+    .header.h = 270,
+    .data_size = sizeof(anim_frame_t),
+    .header.cf = LV_IMG_CF_USER_ENCODED_0,
+    .data = (const uint8_t *)&anim_2088225200_frames[12],
+};
+const lv_img_dsc_t ui_img_1282451900 = {
+    .header.always_zero = 0,
+    .header.w = 480,
+    .header.h = 270,
+    .data_size = sizeof(anim_frame_t),
+    .header.cf = LV_IMG_CF_USER_ENCODED_0,
+    .data = (const uint8_t *)&anim_2088225200_frames[13],
+};
+const lv_img_dsc_t ui_img_200722721 = {
+    .header.always_zero = 0,
+    .header.w = 480,
+    .header.h = 270,
+    .data_size = sizeof(anim_frame_t),
+    .header.cf = LV_IMG_CF_USER_ENCODED_0,
+    .data = (const uint8_t *)&anim_2088225200_frames[14],
+};
+const lv_img_dsc_t ui_img_1303012366 = {
+    .header.always_zero = 0,
+    .header.w = 480,
+    .header.h = 270,
+    .data_size = sizeof(anim_frame_t),
+    .header.cf = LV_IMG_CF_USER_ENCODED_0,
+    .data = (const uint8_t *)&anim_2088225200_frames[15],
+};
+const lv_img_dsc_t ui_img_132363863 = {
+    .header.always_zero = 0,
+    .header.w = 480,
+    .header.h = 270,
+    .data_size = sizeof(anim_frame_t),
+    .header.cf = LV_IMG_CF_USER_ENCODED_0,
+    .data = (const uint8_t *)&anim_2088225200_frames[16],
+};
+const lv_img_dsc_t ui_img_1604146457 = {
+    .header.always_zero = 0,
+    .header.w = 480,
+    .header.h = 270,
+    .data_size = sizeof(anim_frame_t),
+    .header.cf = LV_IMG_CF_USER_ENCODED_0,
+    .data = (const uint8_t *)&anim_2088225200_frames[17],
+};
+const lv_img_dsc_t ui_img_1255444610 = {
+    .header.always_zero = 0,
+    .header.w = 480,
+    .header.h = 270,
+    .data_size = sizeof(anim_frame_t),
+    .header.cf = LV_IMG_CF_USER_ENCODED_0,
+    .data = (const uint8_t *)&anim_2088225200_frames[18],
+};
+const lv_img_dsc_t ui_img_527362481 = {
+    .header.always_zero = 0,
+    .header.w = 480,
+    .header.h = 270,
+    .data_size = sizeof(anim_frame_t),
+    .header.cf = LV_IMG_CF_USER_ENCODED_0,
+    .data = (const uint8_t *)&anim_2088225200_frames[19],
+};
+const lv_img_dsc_t ui_img_1609091660 = {
+    .header.always_zero = 0,
+    .header.w = 480,
+    .header.h = 270,
+    .data_size = sizeof(anim_frame_t),
+    .header.cf = LV_IMG_CF_USER_ENCODED_0,
+    .data = (const uint8_t *)&anim_2088225200_frames[20],
+};
+const lv_img_dsc_t ui_img_881009531 = {
+    .header.always_zero = 0,
+    .header.w = 480,
+    .header.h = 270,
+    .data_size = sizeof(anim_frame_t),
+    .header.cf = LV_IMG_CF_USER_ENCODED_0,
+    .data = (const uint8_t *)&anim_2088225200_frames[21],
+};
+const lv_img_dsc_t ui_img_554366698 = {
+    .header.always_zero = 0,
+    .header.w = 480,
+    .header.h = 270,
+    .data_size = sizeof(anim_frame_t),
+    .header.cf = LV_IMG_CF_USER_ENCODED_0,
+    .data = (const uint8_t *)&anim_2088225200_frames[22],
+};
+const lv_img_dsc_t ui_img_1282448827 = {
+    .header.always_zero = 0,
+    .header.w = 480,
+    .header.h = 270,
+    .data_size = sizeof(anim_frame_t),
+    .header.cf = LV_IMG_CF_USER_ENCODED_0,
+    .data = (const uint8_t *)&anim_2088225200_frames[23],
+};
+const lv_img_dsc_t ui_img_200719648 = {
+    .header.always_zero = 0,
+    .header.w = 480,
+    .header.h = 270,
+    .data_size = sizeof(anim_frame_t),
+    .header.cf = LV_IMG_CF_USER_ENCODED_0,
+    .data = (const uint8_t *)&anim_2088225200_frames[24],
+};
+const lv_img_dsc_t ui_img_1303015439 = {
+    .header.always_zero = 0,
+    .header.w = 480,
+    .header.h = 270,
+    .data_size = sizeof(anim_frame_t),
+    .header.cf = LV_IMG_CF_USER_ENCODED_0,
+    .data = (const uint8_t *)&anim_2088225200_frames[25],
+};
+const lv_img_dsc_t ui_img_132360790 = {
+    .header.always_zero = 0,
+    .header.w = 480,
+    .header.h = 270,
+    .data_size = sizeof(anim_frame_t),
+    .header.cf = LV_IMG_CF_USER_ENCODED_0,
+    .data = (const uint8_t *)&anim_2088225200_frames[26],
+};
+const lv_img_dsc_t ui_img_1604147480 = {
+    .header.always_zero = 0,
+    .header.w = 480,
+    .header.h = 270,
+    .data_size = sizeof(anim_frame_t),
+    .header.cf = LV_IMG_CF_USER_ENCODED_0,
+    .data = (const uint8_t *)&anim_2088225200_frames[27],
+};
+const lv_img_dsc_t ui_img_1255443587 = {
+    .header.always_zero = 0,
+    .header.w = 480,
+    .header.h = 270,
+    .data_size = sizeof(anim_frame_t),
+    .header.cf = LV_IMG_CF_USER_ENCODED_0,
+    .data = (const uint8_t *)&anim_2088225200_frames[28],
+};
+const lv_img_dsc_t ui_img_527361458 = {
+    .header.always_zero = 0,
+    .header.w = 480,
+    .header.h = 270,
+    .data_size = sizeof(anim_frame_t),
+    .header.cf = LV_IMG_CF_USER_ENCODED_0,
+    .data = (const uint8_t *)&anim_2088225200_frames[29],
+};
+const lv_img_dsc_t ui_img_1609090637 = {
+    .header.always_zero = 0,
+    .header.w = 480,
+    .header.h = 270,
+    .data_size = sizeof(anim_frame_t),
+    .header.cf = LV_IMG_CF_USER_ENCODED_0,
+    .data = (const uint8_t *)&anim_2088225200_frames[30],
+};
+const lv_img_dsc_t ui_img_881008508 = {
+    .header.always_zero = 0,
+    .header.w = 480,
+    .header.h = 270,
+    .data_size = sizeof(anim_frame_t),
+    .header.cf = LV_IMG_CF_USER_ENCODED_0,
+    .data = (const uint8_t *)&anim_2088225200_frames[31],
+};
+const lv_img_dsc_t ui_img_554367721 = {
+    .header.always_zero = 0,
+    .header.w = 480,
+    .header.h = 270,
+    .data_size = sizeof(anim_frame_t),
+    .header.cf = LV_IMG_CF_USER_ENCODED_0,
+    .data = (const uint8_t *)&anim_2088225200_frames[32],
+};
+const lv_img_dsc_t ui_img_1282449850 = {
+    .header.always_zero = 0,
+    .header.w = 480,
+    .header.h = 270,
+    .data_size = sizeof(anim_frame_t),
+    .header.cf = LV_IMG_CF_USER_ENCODED_0,
+    .data = (const uint8_t *)&anim_2088225200_frames[33],
+};
+const lv_img_dsc_t ui_img_200720671 = {
+    .header.always_zero = 0,
+    .header.w = 480,
+    .header.h = 270,
+    .data_size = sizeof(anim_frame_t),
+    .header.cf = LV_IMG_CF_USER_ENCODED_0,
+    .data = (const uint8_t *)&anim_2088225200_frames[34],
+};
+const lv_img_dsc_t ui_img_1303014416 = {
+    .header.always_zero = 0,
+    .header.w = 480,
+    .header.h = 270,
+    .data_size = sizeof(anim_frame_t),
+    .header.cf = LV_IMG_CF_USER_ENCODED_0,
+    .data = (const uint8_t *)&anim_2088225200_frames[35],
+};
+
+anim_clip_t *const anim_clips[] = {
+    &anim_2088225200,
+};
+const uint16_t anim_clip_count = 1;
@@ -0,0 +1,161 @@
+// File: src/screen/anim_player.cpp
+#include "anim_player.h"
+#include "anim_codec.h"
+#include "ui/ui.h"
+#include "src/misc/lv_gc.h" // the running animations, to find SquareLine's
+#include <string.h>
+
+static int32_t clampIndex(const anim_player_t *p, int32_t value)
+{
+    if (value < 0)
+        return 0;
+    return value < p->count ? value : p->count - 1;
+}
+
+// Linear like lv_anim_path_linear
+static int32_t valueAt(const anim_player_t *p, uint32_t elapsed)
+{
+    if (elapsed >= p->durationMs)
+        return p->to;
+    return p->from + (int32_t)((int64_t)(p->to - p->from) * elapsed / p->durationMs);
+}
+
+// First elapsed time at which value is reached
+static uint32_t dueMs(const anim_player_t *p, int32_t value)
+{
+    int32_t span = p->to - p->from;
+    if (span <= 0 || value <= p->from)
+        return 0;
+    return (uint32_t)(((int64_t)(value - p->from) * p->durationMs + span - 1) / span);
+}
+
+static void wakeIn(anim_player_t *p, uint32_t ms)
+{
+    lv_timer_set_period(p->timer, ms > 0 ? ms : 1);
+    lv_timer_reset(p->timer);
+}
+
+static void tick(lv_timer_t *timer)
+{
+    anim_player_t *p = (anim_player_t *)timer->user_data;
+    if (!lv_obj_is_valid(p->target))
+    {
+        animPlayerStop(p);
+        return;
+    }
+
+    int32_t elapsed = (int32_t)(lv_tick_get() - p->startMs);
+    if (elapsed < 0)
+    {
+        wakeIn(p, -elapsed);
+        return;
+    }
+
+    // Every value step since the last tick is either the frame shown now,
+    // one that maps to the frame already there, or one we were too late for
+    int32_t value = valueAt(p, elapsed);
+    int32_t frame = clampIndex(p, value);
+    int32_t last = p->shown;
+    for (int32_t v = p->value + 1; v <= value; v++)
+    {
+        int32_t idx = clampIndex(p, v);
+        if (idx == last)
+            p->duplicated++;
+        else if (idx != frame)
+            p->dropped++;
+        last = idx;
+    }
+    if (value > p->value)
+    {
+        p->value = value;
+        if (frame != p->shown)
+        {
+            animCodecShow(p->target, p->frames[frame]);
+            p->shown = frame;
+            p->rendered++;
+            uint32_t late = elapsed - dueMs(p, value);
+            if (late > p->maxLateMs)
+                p->maxLateMs = late;
+        }
+    }
+
+    if (value >= p->to)
+    {
+        animPlayerStop(p);
+        if (p->done != NULL)
+            p->done(p);
+        return;
+    }
+    wakeIn(p, dueMs(p, value + 1) - elapsed);
+}
+
+static void startAt(anim_player_t *p, lv_obj_t *target, const lv_img_dsc_t *const *frames, int32_t count,
+                    int32_t from, int32_t to, uint32_t startMs, uint32_t durationMs, anim_player_done_cb done)
+{
+    animPlayerStop(p);
+    memset(p, 0, sizeof(*p));
+    p->target = target;
+    p->frames = frames;
+    p->count = count;
+    p->from = from;
+    p->to = to;
+    p->durationMs = durationMs;
+    p->startMs = startMs;
+    p->value = from - 1;
+    p->shown = -1;
+    p->done = done;
+
+    const void *src = lv_img_get_src(target);
+    for (int32_t i = 0; i < count; i++)
+        if (frames[i] == src)
+            p->shown = i;
+
+    p->timer = lv_timer_create(tick, 1, p);
+    int32_t wait = (int32_t)(startMs - lv_tick_get());
+    wakeIn(p, wait > 0 ? wait : 0);
+}
+
+void animPlayerStart(anim_player_t *p, lv_obj_t *target, const lv_img_dsc_t *const *frames, int32_t count,
+                     int32_t from, int32_t to, uint32_t delayMs, uint32_t durationMs, anim_player_done_cb done)
+{
+    startAt(p, target, frames, count, from, to, lv_tick_get() + delayMs, durationMs, done);
+}
+
+void animPlayerStop(anim_player_t *p)
+{
+    if (p->timer != NULL)
+        lv_timer_del(p->timer);
+    p->timer = NULL;
+}
+
+bool animPlayerAdopt(anim_player_t *p, lv_obj_t *target, anim_player_done_cb done)
+{
+    lv_anim_t *a = (lv_anim_t *)_lv_ll_get_head(&LV_GC_ROOT(_lv_anim_ll));
+    for (; a != NULL; a = (lv_anim_t *)_lv_ll_get_next(&LV_GC_ROOT(_lv_anim_ll), a))
+    {
+        const ui_anim_user_data_t *usr = (const ui_anim_user_data_t *)a->user_data;
+        if (a->exec_cb == (lv_anim_exec_xcb_t)_ui_anim_callback_set_image_frame && usr != NULL &&
+            usr->target == target)
+            break;
+    }
+    if (a == NULL || a->playback_time != 0 || a->repeat_cnt > 1 || a->path_cb != lv_anim_path_linear)
+        return false;
+
+    // A get_value_cb makes the values relative to the current one, applied
+    // when the delay is over. act_time is negative while still delayed.
+    const ui_anim_user_data_t *usr = (const ui_anim_user_data_t *)a->user_data;
+    int32_t offset = (a->act_time < 0 && a->get_value_cb != NULL) ? a->get_value_cb(a) : 0;
+    const lv_img_dsc_t *const *frames = usr->imgset;
+    int32_t count = usr->imgset_size;
+    int32_t from = a->start_value + offset;
+    int32_t to = a->end_value + offset;
+    // The player only counts up; a reversed animation stays with LVGL
+    if (to < from)
+        return false;
+    uint32_t startMs = lv_tick_get() - a->act_time;
+    uint32_t durationMs = a->time;
+
+    lv_anim_del(a->var, a->exec_cb); // frees SquareLine's user data
+    startAt(p, target, frames, count, from, to, startMs, durationMs, done);
+    return true;
+}
@@ -0,0 +1,49 @@
+// File: src/screen/anim_player.h
+// Plays an image set on an lv_img by the clock. SquareLine drives image
+// sets through an lv_anim whose callback calls lv_img_set_src() on every
+// step, so the whole image is invalidated even when the frame did not
+// change. The player instead wakes up when the next frame is due, sets
+// the source only when the frame index changed, and if it is late it
+// jumps to the frame due now instead of playing the ones it missed.
+// Tiled frames (anim_codec.h) then only redraw the tiles that changed.
+#pragma once
+
+#include <lvgl.h>
+
+typedef struct anim_player_t anim_player_t;
+typedef void (*anim_player_done_cb)(const anim_player_t *player);
+
+struct anim_player_t
+{
+    lv_obj_t *target;
+    const lv_img_dsc_t *const *frames;
+    int32_t count;
+    // Values from..to are spread linearly over durationMs and used as
+    // frame indexes, clamped to the set, as SquareLine does
+    int32_t from;
+    int32_t to;
+    uint32_t durationMs;
+    uint32_t startMs; // tick at which the value is `from`
+    int32_t value;    // last value handled
+    int32_t shown;    // frame index on screen, -1 before the first
+    lv_timer_t *timer;
+    anim_player_done_cb done;
+
+    // Statistics
+    uint32_t rendered;   // frames handed to the image
+    uint32_t dropped;    // frames skipped because the player was late
+    uint32_t duplicated; // steps that mapped to the frame already shown
+    uint32_t maxLateMs;
+};
+
+// Starts playing after delayMs. done (may be NULL) runs when the last
+// value was reached.
+void animPlayerStart(anim_player_t *p, lv_obj_t *target, const lv_img_dsc_t *const *frames, int32_t count,
+                     int32_t from, int32_t to, uint32_t delayMs, uint32_t durationMs, anim_player_done_cb done);
+void animPlayerStop(anim_player_t *p);
+
+// Finds a SquareLine image set animation on target, deletes it and
+// plays the same frames with the same timing on p instead. False if
+// there is none, or it repeats, plays back or runs backwards, which the
+// player does not do.
+bool animPlayerAdopt(anim_player_t *p, lv_obj_t *target, anim_player_done_cb done);
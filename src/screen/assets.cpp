@@ -0,0 +1,116 @@
+// File: src/screen/assets.cpp
+#include "assets.h"
+#include <string.h>
+
+#ifdef ARDUINO
+#include <esp_partition.h>
+#endif
+
+static_assert(sizeof(asset_header_t) == 16, "asset header layout is shared with tools/pack_assets.py");
+static_assert(sizeof(asset_entry_t) == 40, "asset entry layout is shared with tools/pack_assets.py");
+
+static const uint8_t *packBase = NULL;
+static const asset_header_t *header = NULL;
+static const asset_entry_t *table = NULL;
+static const char *openError = "not opened";
+
+// CRC-32 as zlib.crc32(), a nibble at a time
+static uint32_t crc32(const uint8_t *p, uint32_t len)
+{
+    static const uint32_t nibble[16] = {
+        0x00000000, 0x1DB71064, 0x3B6E20C8, 0x26D930AC, 0x76DC4190, 0x6B6B51F4, 0x4DB26158, 0x5005713C,
+        0xEDB88320, 0xF00F9344, 0xD6D6A3E8, 0xCB61B38C, 0x9B64C2B0, 0x86D3D2D4, 0xA00AE278, 0xBDBDF21C,
+    };
+    uint32_t crc = 0xFFFFFFFF;
+    while (len--)
+    {
+        crc ^= *p++;
+        crc = (crc >> 4) ^ nibble[crc & 0x0F];
+        crc = (crc >> 4) ^ nibble[crc & 0x0F];
+    }
+    return ~crc;
+}
+
+static bool fail(const char *why)
+{
+    packBase = NULL;
+    header = NULL;
+    table = NULL;
+    openError = why;
+    return false;
+}
+
+bool assetsOpen(const uint8_t *base, uint32_t size)
+{
+    if (base == NULL || size < sizeof(asset_header_t))
+        return fail("no pack");
+    const asset_header_t *h = (const asset_header_t *)base;
+    if (h->magic != ASSET_MAGIC)
+        return fail("no pack (bad magic), run tools/pack_assets.py and flash it");
+    if (h->version != ASSET_VERSION)
+        return fail("pack version not supported");
+    uint32_t tableEnd = sizeof(asset_header_t) + (uint32_t)h->count * sizeof(asset_entry_t);
+    if (h->size > size || h->size < tableEnd)
+        return fail("pack truncated");
+    if (crc32(base + sizeof(asset_header_t), h->size - sizeof(asset_header_t)) != h->crc)
+        return fail("pack CRC mismatch");
+
+    const asset_entry_t *t = (const asset_entry_t *)(base + sizeof(asset_header_t));
+    for (uint16_t i = 0; i < h->count; i++)
+    {
+        if (t[i].offset < tableEnd || t[i].offset > h->size || t[i].size > h->size - t[i].offset ||
+            memchr(t[i].name, '\0', ASSET_NAME_MAX) == NULL)
+            return fail("bad entry in pack");
+    }
+
+    packBase = base;
+    header = h;
+    table = t;
+    openError = NULL;
+    return true;
+}
+
+const char *assetsError(void)
+{
+    return openError != NULL ? openError : "none";
+}
+
+uint16_t assetsCount(void)
+{
+    return header != NULL ? header->count : 0;
+}
+
+uint32_t assetsSize(void)
+{
+    return header != NULL ? header->size : 0;
+}
+
+const asset_entry_t *assetsFind(const char *name)
+{
+    for (uint16_t i = 0; i < assetsCount(); i++)
+        if (strcmp(table[i].name, name) == 0)
+            return &table[i];
+    return NULL;
+}
+
+const uint8_t *assetsData(const asset_entry_t *entry)
+{
+    return packBase + entry->offset;
+}
+
+#ifdef ARDUINO
+bool assetsBegin(void)
+{
+    const esp_partition_t *part =
+        esp_partition_find_first(ESP_PARTITION_TYPE_DATA, ESP_PARTITION_SUBTYPE_ANY, ASSET_PARTITION_LABEL);
+    if (part == NULL)
+        return fail("no asset partition in the partition table");
+
+    // Mapped for good; the data cache fetches it from flash as it is read
+    const void *mapped = NULL;
+    spi_flash_mmap_handle_t handle;
+    if (esp_partition_mmap(part, 0, part->size, SPI_FLASH_MMAP_DATA, &mapped, &handle) != ESP_OK)
+        return fail("cannot map the asset partition");
+    return assetsOpen((const uint8_t *)mapped, part->size);
+}
+#endif
@@ -0,0 +1,61 @@
+// File: src/screen/assets.h
+// Read-only asset pack in its own flash partition, built and flashed
+// with tools/pack_assets.py. On the screen the partition is memory
+// mapped, so entries are used in place and never copied to RAM; the
+// simulator hands in the same image loaded from a file.
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define ASSET_PARTITION_LABEL "assets"
+#define ASSET_MAGIC 0x31414754 // "TGA1"
+#define ASSET_VERSION 2
+#define ASSET_NAME_MAX 24
+#define ASSET_FLAG_TILES 0x02 // tile store shared by the frames of an animation
+
+typedef struct asset_header_t
+{
+    uint32_t magic;
+    uint16_t version;
+    uint16_t count;
+    uint32_t size; // whole pack, header included
+    uint32_t crc;  // CRC-32 of everything after the header
+} asset_header_t;
+
+typedef struct asset_entry_t
+{
+    char name[ASSET_NAME_MAX]; // NUL terminated
+    uint32_t offset;           // from the start of the pack
+    uint32_t size;
+    uint16_t w;
+    uint16_t h;
+    uint8_t cf; // LVGL colour format of the blob
+    uint8_t flags;
+    uint16_t reserved;
+} asset_entry_t;
+
+#ifdef ARDUINO
+// Maps the asset partition and checks it
+bool assetsBegin(void);
+#endif
+
+// Checks a pack at base and makes it the current one. False if it is
+// missing, truncated or corrupt; assetsError() says why.
+bool assetsOpen(const uint8_t *base, uint32_t size);
+const char *assetsError(void);
+
+uint16_t assetsCount(void);
+uint32_t assetsSize(void);
+
+// NULL if there is no pack or no entry of that name
+const asset_entry_t *assetsFind(const char *name);
+const uint8_t *assetsData(const asset_entry_t *entry);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,32 @@
+// File: src/screen/board.h
+// Pinout and panel timings of the screen board: ESP32-S3 with a 4.3"
+// 480x272 RGB565 parallel panel (ESP32-4827S043 layout). Change here for
+// another panel.
+#pragma once
+
+#define SCREEN_WIDTH 480
+#define SCREEN_HEIGHT 272
+
+// --- RGB PANEL ---
+#define PIN_LCD_DE 40
+#define PIN_LCD_VSYNC 41
+#define PIN_LCD_HSYNC 39
+#define PIN_LCD_PCLK 42
+#define PIN_LCD_BACKLIGHT 2
+
+// Bus order is B0..B4, G0..G5, R0..R4
+#define LCD_DATA_PINS {8, 3, 46, 9, 1, 5, 6, 7, 15, 16, 4, 45, 48, 47, 21, 14}
+
+#define LCD_PCLK_HZ (9 * 1000 * 1000)
+#define LCD_HSYNC_BACK_PORCH 43
+#define LCD_HSYNC_FRONT_PORCH 8
+#define LCD_HSYNC_PULSE 4
+#define LCD_VSYNC_BACK_PORCH 12
+#define LCD_VSYNC_FRONT_PORCH 8
+#define LCD_VSYNC_PULSE 4
+
+// --- HUB LINK ---
+// UART from the hub's PIN_TX_TO_SCREEN / PIN_RX_FROM_SCREEN
+#define PIN_RX_FROM_HUB 18
+#define PIN_TX_TO_HUB 17
+#define HUB_BAUD 115200
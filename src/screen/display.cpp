@@ -0,0 +1,240 @@
+// File: src/screen/display.cpp
+#include "display.h"
+#include "board.h"
+#include <lvgl.h>
+#include <esp_heap_caps.h>
+#include <esp_lcd_panel_ops.h>
+#include <esp_lcd_panel_rgb.h>
+
+#define DRAW_BUF_PIXELS (SCREEN_WIDTH * DISPLAY_BUF_LINES)
+
+typedef struct flush_job_t
+{
+    lv_disp_drv_t *drv;
+    lv_area_t area;
+    lv_color_t *pixels;
+} flush_job_t;
+
+// Counters since the last report. frames/renderMs from the LVGL task,
+// flushes/flushUs from whichever task flushes.
+typedef struct display_stats_t
+{
+    uint32_t frames;
+    uint32_t renderMs;
+    uint32_t pixels;
+    uint32_t flushes;
+    uint64_t flushUs;
+    uint32_t flushMaxUs;
+    uint64_t waitUs; // LVGL idle because both buffers were busy
+} display_stats_t;
+
+static esp_lcd_panel_handle_t panel = NULL;
+static lv_disp_draw_buf_t drawBuf;
+static lv_disp_drv_t dispDrv;
+static SemaphoreHandle_t lvglMutex = NULL;
+static TaskHandle_t lvglTaskHandle = NULL;
+
+static StaticQueue_t flushQueueBuffer;
+static uint8_t flushQueueStorage[2 * sizeof(flush_job_t)];
+static QueueHandle_t flushQueue = NULL;
+
+static display_stats_t stats;
+static portMUX_TYPE statsLock = portMUX_INITIALIZER_UNLOCKED;
+static uint32_t statsSinceMs = 0;
+
+static bool panelBegin()
+{
+    static const int dataPins[16] = LCD_DATA_PINS;
+
+    esp_lcd_rgb_panel_config_t cfg;
+    memset(&cfg, 0, sizeof(cfg));
+    cfg.clk_src = LCD_CLK_SRC_PLL160M;
+    cfg.timings.pclk_hz = LCD_PCLK_HZ;
+    cfg.timings.h_res = SCREEN_WIDTH;
+    cfg.timings.v_res = SCREEN_HEIGHT;
+    cfg.timings.hsync_back_porch = LCD_HSYNC_BACK_PORCH;
+    cfg.timings.hsync_front_porch = LCD_HSYNC_FRONT_PORCH;
+    cfg.timings.hsync_pulse_width = LCD_HSYNC_PULSE;
+    cfg.timings.vsync_back_porch = LCD_VSYNC_BACK_PORCH;
+    cfg.timings.vsync_front_porch = LCD_VSYNC_FRONT_PORCH;
+    cfg.timings.vsync_pulse_width = LCD_VSYNC_PULSE;
+    cfg.timings.flags.pclk_active_neg = 1;
+    cfg.data_width = 16;
+    cfg.psram_trans_align = 64;
+    cfg.hsync_gpio_num = PIN_LCD_HSYNC;
+    cfg.vsync_gpio_num = PIN_LCD_VSYNC;
+    cfg.de_gpio_num = PIN_LCD_DE;
+    cfg.pclk_gpio_num = PIN_LCD_PCLK;
+    cfg.disp_gpio_num = -1;
+    for (int i = 0; i < 16; i++)
+        cfg.data_gpio_nums[i] = dataPins[i];
+    cfg.flags.fb_in_psram = 1; // the panel scans out of this, LVGL never sees it
+
+    if (esp_lcd_new_rgb_panel(&cfg, &panel) != ESP_OK)
+        return false;
+    esp_lcd_panel_reset(panel);
+    esp_lcd_panel_init(panel);
+
+    pinMode(PIN_LCD_BACKLIGHT, OUTPUT);
+    digitalWrite(PIN_LCD_BACKLIGHT, HIGH);
+    return true;
+}
+
+// Copies one rendered area into the panel's frame buffer
+static void pushToPanel(const lv_area_t *area, const lv_color_t *pixels)
+{
+    uint32_t start = micros();
+    esp_lcd_panel_draw_bitmap(panel, area->x1, area->y1, area->x2 + 1, area->y2 + 1, pixels);
+    uint32_t us = micros() - start;
+
+    portENTER_CRITICAL(&statsLock);
+    stats.flushes++;
+    stats.flushUs += us;
+    if (us > stats.flushMaxUs)
+        stats.flushMaxUs = us;
+    portEXIT_CRITICAL(&statsLock);
+}
+
+static void flushCb(lv_disp_drv_t *drv, const lv_area_t *area, lv_color_t *pixels)
+{
+#if DISPLAY_BUF_COUNT >= 2
+    // LVGL goes on drawing into the other buffer meanwhile
+    flush_job_t job = {drv, *area, pixels};
+    xQueueSend(flushQueue, &job, portMAX_DELAY);
+#else
+    pushToPanel(area, pixels);
+    lv_disp_flush_ready(drv);
+#endif
+}
+
+#if DISPLAY_BUF_COUNT >= 2
+static void flushTask(void *param)
+{
+    flush_job_t job;
+    for (;;)
+    {
+        if (xQueueReceive(flushQueue, &job, portMAX_DELAY) != pdTRUE)
+            continue;
+        pushToPanel(&job.area, job.pixels);
+        lv_disp_flush_ready(job.drv);
+        if (lvglTaskHandle != NULL)
+            xTaskNotifyGive(lvglTaskHandle);
+    }
+}
+
+// LVGL wants to draw but both buffers are still being flushed
+static void waitCb(lv_disp_drv_t *drv)
+{
+    uint32_t start = micros();
+    ulTaskNotifyTake(pdTRUE, 1);
+    uint32_t us = micros() - start;
+
+    portENTER_CRITICAL(&statsLock);
+    stats.waitUs += us;
+    portEXIT_CRITICAL(&statsLock);
+}
+#endif
+
+static void monitorCb(lv_disp_drv_t *drv, uint32_t timeMs, uint32_t pixels)
+{
+    portENTER_CRITICAL(&statsLock);
+    stats.frames++;
+    stats.renderMs += timeMs;
+    stats.pixels += pixels;
+    portEXIT_CRITICAL(&statsLock);
+}
+
+static void lvglTask(void *param)
+{
+    for (;;)
+    {
+        displayLock();
+        uint32_t next = lv_timer_handler();
+        displayUnlock();
+        vTaskDelay(pdMS_TO_TICKS(constrain(next, (uint32_t)1, (uint32_t)DISPLAY_MAX_SLEEP_MS)));
+    }
+}
+
+bool displayBegin()
+{
+    if (!panelBegin())
+    {
+        Serial.println("Error initializing the RGB panel");
+        return false;
+    }
+
+    uint32_t caps = DISPLAY_BUF_PSRAM ? MALLOC_CAP_SPIRAM : (MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+    lv_color_t *buf1 = (lv_color_t *)heap_caps_malloc(DRAW_BUF_PIXELS * sizeof(lv_color_t), caps);
+    lv_color_t *buf2 = NULL;
+    if (DISPLAY_BUF_COUNT >= 2)
+        buf2 = (lv_color_t *)heap_caps_malloc(DRAW_BUF_PIXELS * sizeof(lv_color_t), caps);
+    if (buf1 == NULL || (DISPLAY_BUF_COUNT >= 2 && buf2 == NULL))
+    {
+        Serial.println("Error allocating the draw buffers");
+        return false;
+    }
+
+    lv_init();
+    lv_disp_draw_buf_init(&drawBuf, buf1, buf2, DRAW_BUF_PIXELS);
+    lv_disp_drv_init(&dispDrv);
+    dispDrv.hor_res = SCREEN_WIDTH;
+    dispDrv.ver_res = SCREEN_HEIGHT;
+    dispDrv.draw_buf = &drawBuf;
+    dispDrv.flush_cb = flushCb;
+    dispDrv.monitor_cb = monitorCb;
+#if DISPLAY_BUF_COUNT >= 2
+    dispDrv.wait_cb = waitCb;
+#endif
+    lv_disp_drv_register(&dispDrv);
+
+    // The flush side has to be up before LVGL renders its first frame
+    lvglMutex = xSemaphoreCreateRecursiveMutex();
+#if DISPLAY_BUF_COUNT >= 2
+    flushQueue = xQueueCreateStatic(2, sizeof(flush_job_t), flushQueueStorage, &flushQueueBuffer);
+    xTaskCreatePinnedToCore(flushTask, "flush", 4096, NULL, DISPLAY_FLUSH_PRIORITY, NULL, 0);
+#endif
+    xTaskCreatePinnedToCore(lvglTask, "lvgl", DISPLAY_TASK_STACK, NULL, DISPLAY_TASK_PRIORITY, &lvglTaskHandle, 1);
+
+    statsSinceMs = millis();
+    Serial.printf("Display %ux%u, %u draw buffer(s) of %u lines in %s (%u bytes each)\n", SCREEN_WIDTH,
+                  SCREEN_HEIGHT, DISPLAY_BUF_COUNT, DISPLAY_BUF_LINES, DISPLAY_BUF_PSRAM ? "PSRAM" : "internal RAM",
+                  (unsigned)(DRAW_BUF_PIXELS * sizeof(lv_color_t)));
+    return true;
+}
+
+void displayLock()
+{
+    xSemaphoreTakeRecursive(lvglMutex, portMAX_DELAY);
+}
+
+void displayUnlock()
+{
+    xSemaphoreGiveRecursive(lvglMutex);
+}
+
+void displayPrintStats(Print &out)
+{
+    display_stats_t s;
+    portENTER_CRITICAL(&statsLock);
+    s = stats;
+    memset(&stats, 0, sizeof(stats));
+    portEXIT_CRITICAL(&statsLock);
+
+    uint32_t now = millis();
+    float seconds = (now - statsSinceMs) / 1000.0f;
+    statsSinceMs = now;
+    if (seconds <= 0)
+        return;
+
+    out.printf("Display: %.1f fps, %.1f ms render/frame, %.0f px/frame\n", s.frames / seconds,
+               s.frames ? (float)s.renderMs / s.frames : 0.0f, s.frames ? (float)s.pixels / s.frames : 0.0f);
+    out.printf("  %u flushes, avg %.2f ms, max %.2f ms, %.1f ms waiting for a free buffer\n",
+               (unsigned)s.flushes, s.flushes ? s.flushUs / 1000.0f / s.flushes : 0.0f, s.flushMaxUs / 1000.0f,
+               s.waitUs / 1000.0f);
+}
+
+void displayPoll()
+{
+    if (DISPLAY_STATS_INTERVAL_MS > 0 && millis() - statsSinceMs >= DISPLAY_STATS_INTERVAL_MS)
+        displayPrintStats(Serial);
+}
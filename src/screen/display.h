@@ -0,0 +1,37 @@
+// File: src/screen/display.h
+// LVGL display driver for the RGB panel. LVGL renders changed areas into
+// partial draw buffers; with two of them a flush task copies one into the
+// panel's frame buffer while LVGL already draws the next area into the
+// other. lv_timer_handler() runs on its own task, so anything else that
+// touches LVGL objects must hold displayLock().
+#pragma once
+
+#include <Arduino.h>
+
+// Buffer strategy, normally set from platformio.ini
+#ifndef DISPLAY_BUF_LINES
+#define DISPLAY_BUF_LINES 40 // lines per draw buffer
+#endif
+#ifndef DISPLAY_BUF_COUNT
+#define DISPLAY_BUF_COUNT 2 // 1 = flush inline, 2 = flush on the flush task
+#endif
+#ifndef DISPLAY_BUF_PSRAM
+#define DISPLAY_BUF_PSRAM 0 // draw buffers in PSRAM (slower, saves internal RAM)
+#endif
+
+#define DISPLAY_TASK_STACK 8192
+#define DISPLAY_TASK_PRIORITY 2
+#define DISPLAY_FLUSH_PRIORITY 3
+#define DISPLAY_MAX_SLEEP_MS 20
+#define DISPLAY_STATS_INTERVAL_MS 10000 // 0 = no periodic report
+
+// Sets up the panel and LVGL and starts the LVGL task. False if the
+// panel or the draw buffers could not be set up.
+bool displayBegin();
+
+void displayLock();
+void displayUnlock();
+
+// Frame rate, render and flush times since the last report, then resets
+void displayPrintStats(Print &out);
+void displayPoll();
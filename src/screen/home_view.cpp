@@ -0,0 +1,80 @@
+// File: src/screen/home_view.cpp
+#include "home_view.h"
+#include "prescale.h"
+#include "ui/ui.h"
+
+#define TILE_COUNT 6
+
+// Tile order: top row left to right, then the bottom row
+enum
+{
+    TILE_TEMP,
+    TILE_HUMIDITY,
+    TILE_PRESSURE,
+    TILE_LIGHT,
+    TILE_RAIN,
+    TILE_SIGNAL,
+};
+
+static const char *const tileCaptions[TILE_COUNT] = {"Air temp", "Humidity", "Pressure", "Light", "Rain", "Signal"};
+static lv_obj_t *valueLabels[TILE_COUNT];
+
+static lv_obj_t *themedLabel(lv_obj_t *parent, const char *text, const lv_font_t *font, lv_align_t align)
+{
+    lv_obj_t *label = lv_label_create(parent);
+    lv_label_set_text(label, text);
+    lv_obj_set_align(label, align);
+    lv_obj_set_style_text_font(label, font, LV_PART_MAIN | LV_STATE_DEFAULT);
+    ui_object_set_themeable_style_property(label, LV_PART_MAIN | LV_STATE_DEFAULT, LV_STYLE_TEXT_COLOR,
+                                           _ui_theme_color_button2);
+    ui_object_set_themeable_style_property(label, LV_PART_MAIN | LV_STATE_DEFAULT, LV_STYLE_TEXT_OPA,
+                                           _ui_theme_alpha_button2);
+    return label;
+}
+
+// The tiles belong to the home screen, which SquareLine may delete and
+// rebuild; the labels are (re)created whenever they are gone, and the
+// rebuilt screen's pre-scaled images fixed up again
+static bool ensureLabels()
+{
+    lv_obj_t *tiles[TILE_COUNT] = {ui_Panel5, ui_Panel9, ui_Panel8, ui_Panel6, ui_Panel7, ui_Panel10};
+    if (ui_home_screen == NULL)
+        return false;
+    if (valueLabels[0] != NULL && lv_obj_is_valid(valueLabels[0]))
+        return true;
+
+    for (int i = 0; i < TILE_COUNT; i++)
+    {
+        lv_obj_set_style_pad_all(tiles[i], 4, LV_PART_MAIN | LV_STATE_DEFAULT);
+        themedLabel(tiles[i], tileCaptions[i], &lv_font_montserrat_14, LV_ALIGN_TOP_MID);
+        valueLabels[i] = themedLabel(tiles[i], "--", &lv_font_montserrat_20, LV_ALIGN_BOTTOM_MID);
+    }
+    prescaleApply();
+    return true;
+}
+
+void homeViewUpdate(const hub_telemetry_t *t)
+{
+    if (!ensureLabels())
+        return;
+
+    lv_label_set_text_fmt(valueLabels[TILE_TEMP], "%.1f C", t->tempC);
+    lv_label_set_text_fmt(valueLabels[TILE_HUMIDITY], "%.0f %%", t->humidity);
+    lv_label_set_text_fmt(valueLabels[TILE_PRESSURE], "%.0f", t->pressureHpa);
+    lv_label_set_text_fmt(valueLabels[TILE_LIGHT], "%u", (unsigned)t->lux);
+    lv_label_set_text(valueLabels[TILE_RAIN], t->rain == LOW ? "Wet" : "Dry");
+    if (t->hasLink)
+        lv_label_set_text_fmt(valueLabels[TILE_SIGNAL], "%d dBm", t->rssi);
+    else
+        lv_label_set_text(valueLabels[TILE_SIGNAL], "--");
+
+    // Series in creation order: humidity, light (secondary axis), temperature
+    lv_chart_series_t *humidity = lv_chart_get_series_next(ui_Chart1, NULL);
+    lv_chart_series_t *light = humidity ? lv_chart_get_series_next(ui_Chart1, humidity) : NULL;
+    lv_chart_series_t *temp = light ? lv_chart_get_series_next(ui_Chart1, light) : NULL;
+    if (temp == NULL)
+        return;
+    lv_chart_set_next_value(ui_Chart1, humidity, (lv_coord_t)lroundf(t->humidity));
+    lv_chart_set_next_value(ui_Chart1, light, (lv_coord_t)min(t->lux, (uint32_t)8000));
+    lv_chart_set_next_value(ui_Chart1, temp, (lv_coord_t)lroundf(t->tempC));
+}
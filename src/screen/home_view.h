@@ -0,0 +1,10 @@
+// File: src/screen/home_view.h
+// Puts hub telemetry on the SquareLine home screen. The generated files
+// under ui/ are left untouched: value labels are added to the empty tiles
+// (ui_Panel5..10) at runtime and the chart gets live points instead of
+// its design-time sample data. Call with displayLock() held.
+#pragma once
+
+#include "hub_link.h"
+
+void homeViewUpdate(const hub_telemetry_t *t);
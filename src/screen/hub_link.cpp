@@ -0,0 +1,97 @@
+// File: src/screen/hub_link.cpp
+#include "hub_link.h"
+#include "board.h"
+#include "line_reader.h"
+
+#define HUB_LINE_MAX 128
+
+static line_reader_t<HUB_LINE_MAX, 1> hubLine;
+
+// Statistics
+static uint32_t linesOk = 0;
+static uint32_t linesBad = 0;
+static uint32_t lastRxMs = 0;
+
+void hubLinkBegin()
+{
+    Serial1.begin(HUB_BAUD, SERIAL_8N1, PIN_RX_FROM_HUB, PIN_TX_TO_HUB);
+    lineReaderInit(&hubLine, false);
+}
+
+// Splits "K=V;K=V;..." in place. Fields the hub did not send keep their
+// defaults; a line without T, H and L is rejected. Lines longer than
+// HUB_LINE_MAX never get here, the reader discards them whole.
+static bool parseLine(char *line, hub_telemetry_t *t)
+{
+    memset(t, 0, sizeof(*t));
+    uint8_t seen = 0;
+    char *save = NULL;
+    for (char *field = strtok_r(line, ";", &save); field != NULL; field = strtok_r(NULL, ";", &save))
+    {
+        if (field[0] == '\0' || field[1] != '=')
+            return false;
+        const char *v = field + 2;
+        switch (field[0])
+        {
+        case 'T':
+            t->tempC = strtof(v, NULL);
+            seen |= 0x01;
+            break;
+        case 'H':
+            t->humidity = strtof(v, NULL);
+            seen |= 0x02;
+            break;
+        case 'P':
+            t->pressureHpa = strtof(v, NULL);
+            break;
+        case 'L':
+            t->lux = strtoul(v, NULL, 10);
+            seen |= 0x04;
+            break;
+        case 'R':
+            t->rain = (uint8_t)atoi(v);
+            break;
+        case 'F':
+            t->fert = (uint8_t)atoi(v);
+            break;
+        case 'S':
+            t->rssi = (int8_t)atoi(v);
+            t->hasLink = true;
+            break;
+        case 'Q':
+            t->lossPermille = (uint16_t)strtoul(v, NULL, 10);
+            break;
+        default:
+            break; // newer hub firmware, ignore
+        }
+    }
+    return seen == 0x07;
+}
+
+bool hubLinkPoll(hub_telemetry_t *out)
+{
+    const char *text = lineReaderPoll(&hubLine, Serial1, (HardwareSerial *)NULL);
+    if (text == NULL)
+        return false;
+
+    char line[HUB_LINE_MAX];
+    strncpy(line, text, sizeof(line) - 1);
+    line[sizeof(line) - 1] = '\0';
+    if (!parseLine(line, out))
+    {
+        linesBad++;
+        return false;
+    }
+    linesOk++;
+    lastRxMs = millis();
+    return true;
+}
+
+void hubLinkPrint(Print &out)
+{
+    out.printf("Hub link: %u lines, %u rejected, %u too long", (unsigned)linesOk, (unsigned)linesBad,
+               (unsigned)hubLine.overflows);
+    if (linesOk > 0)
+        out.printf(", last %u ms ago", (unsigned)(millis() - lastRxMs));
+    out.println();
+}
@@ -0,0 +1,28 @@
+// File: src/screen/hub_link.h
+// Telemetry lines from the hub over UART, as sent by sendSensorPacket():
+//   T=21.5;H=48;P=1013;L=320;R=1;F=0;S=-61;Q=12;\n
+// S (RSSI, dBm) and Q (loss, 0.1 %) are only there once a remote was heard.
+#pragma once
+
+#include <Arduino.h>
+
+typedef struct hub_telemetry_t
+{
+    float tempC;
+    float humidity;
+    float pressureHpa;
+    uint32_t lux;
+    uint8_t rain; // LOW = wet
+    uint8_t fert;
+    bool hasLink;
+    int8_t rssi;
+    uint16_t lossPermille;
+} hub_telemetry_t;
+
+void hubLinkBegin();
+
+// Reads what the UART has without blocking. True when a complete line
+// was parsed into out.
+bool hubLinkPoll(hub_telemetry_t *out);
+
+void hubLinkPrint(Print &out);
@@ -0,0 +1,52 @@
+// File: src/screen/lv_conf.h
+// LVGL 8.3 configuration for the screen. Only what differs from LVGL's
+// defaults is listed; SquareLine expects 16-bit colour without byte swap.
+#if 1 // enable content
+
+#ifndef LV_CONF_H
+#define LV_CONF_H
+
+#include <stdint.h>
+
+// --- COLOUR ---
+#define LV_COLOR_DEPTH 16
+#define LV_COLOR_16_SWAP 0
+
+// --- MEMORY ---
+// Objects and styles come from the C heap (internal RAM first on the S3)
+#define LV_MEM_CUSTOM 1
+#define LV_MEM_CUSTOM_INCLUDE <stdlib.h>
+#define LV_MEM_CUSTOM_ALLOC malloc
+#define LV_MEM_CUSTOM_FREE free
+#define LV_MEM_CUSTOM_REALLOC realloc
+
+// --- TIMING ---
+#define LV_DISP_DEF_REFR_PERIOD 16
+#define LV_INDEV_DEF_READ_PERIOD 30
+
+#define LV_TICK_CUSTOM 1
+#ifdef ARDUINO
+#define LV_TICK_CUSTOM_INCLUDE "Arduino.h"
+#define LV_TICK_CUSTOM_SYS_TIME_EXPR (millis())
+#else
+// Host simulator (src/screen_sim): a virtual clock the script advances
+#define LV_TICK_CUSTOM_INCLUDE "sim_tick.h"
+#define LV_TICK_CUSTOM_SYS_TIME_EXPR (simTickMs())
+#endif
+
+// --- FEATURES ---
+#define LV_USE_LOG 0
+#define LV_USE_ASSERT_NULL 1
+#define LV_USE_ASSERT_MALLOC 1
+#define LV_USE_PERF_MONITOR 0
+#define LV_SPRINTF_USE_FLOAT 1
+
+#define LV_FONT_MONTSERRAT_14 1
+#define LV_FONT_MONTSERRAT_20 1
+#define LV_FONT_DEFAULT &lv_font_montserrat_14
+
+#define LV_USE_THEME_DEFAULT 1
+
+#endif // LV_CONF_H
+
+#endif // enable content
@@ -0,0 +1,89 @@
+#include <Arduino.h>
+#include "anim_codec.h"
+#include "assets.h"
+#include "display.h"
+#include "hub_link.h"
+#include "home_view.h"
+#include "opening_view.h"
+#include "prescale.h"
+#include "ui/ui.h"
+
+// --- SCREEN ---
+// LVGL runs on its own task (display.cpp); loop() only feeds it hub
+// telemetry, taking the display lock around every UI change.
+
+#define LINK_STATS_INTERVAL_MS 60000
+
+static uint32_t lastLinkStatsMs = 0;
+static bool displayOk = false;
+
+static void printAnimStats()
+{
+    if (!displayOk)
+        return;
+    anim_codec_stats_t s;
+    displayLock();
+    animCodecTakeStats(&s);
+    displayUnlock();
+    if (s.frames > 0)
+    {
+        Serial.printf("Animation: %u frames decoded (%u tiles), avg %.2f ms, max %.2f ms, %u errors\n",
+                      (unsigned)s.frames, (unsigned)s.tiles, s.decodeUs / 1000.0f / s.frames, s.maxUs / 1000.0f,
+                      (unsigned)s.errors);
+        if (s.shows > 0)
+            Serial.printf("Animation: %.0f px redrawn per frame change\n", (float)s.shownPx / s.shows);
+    }
+}
+
+// Runs on the LVGL task when the boot animation has played
+static void printBootAnim(const anim_player_t *p)
+{
+    Serial.printf("Boot animation: %u frames rendered, %u dropped, %u duplicated, max %u ms late\n",
+                  (unsigned)p->rendered, (unsigned)p->dropped, (unsigned)p->duplicated, (unsigned)p->maxLateMs);
+}
+
+void setup()
+{
+    Serial.begin(115200);
+    hubLinkBegin();
+
+    displayOk = displayBegin();
+    if (!displayOk)
+        return;
+
+    if (assetsBegin())
+        Serial.printf("Assets: %u entries, %u bytes\n", assetsCount(), (unsigned)assetsSize());
+    else
+        Serial.printf("Assets: %s\n", assetsError());
+
+    displayLock();
+    if (!animCodecBegin())
+        Serial.println("Boot animation frames missing from the asset pack");
+    ui_init();
+    prescaleApply();
+    openingViewBegin(printBootAnim);
+    displayUnlock();
+
+    Serial.println("--- SCREEN READY ---");
+}
+
+void loop()
+{
+    hub_telemetry_t t;
+    if (hubLinkPoll(&t) && displayOk)
+    {
+        displayLock();
+        homeViewUpdate(&t);
+        displayUnlock();
+    }
+
+    if (displayOk)
+        displayPoll();
+    if (millis() - lastLinkStatsMs >= LINK_STATS_INTERVAL_MS)
+    {
+        lastLinkStatsMs = millis();
+        hubLinkPrint(Serial);
+        printAnimStats();
+    }
+    delay(5);
+}
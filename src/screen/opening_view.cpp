@@ -0,0 +1,22 @@
+// File: src/screen/opening_view.cpp
+#include "opening_view.h"
+#include "ui/ui.h"
+
+static anim_player_t bootPlayer;
+static anim_player_done_cb bootDone = NULL;
+
+// Runs after the generated handler, which was added first
+static void onScreenLoaded(lv_event_t *e)
+{
+    animPlayerAdopt(&bootPlayer, ui_Image1, bootDone);
+}
+
+void openingViewBegin(anim_player_done_cb done)
+{
+    bootDone = done;
+    if (ui_opening_screen == NULL)
+        return;
+    // ui_init() has loaded the screen already, so the animation is running
+    animPlayerAdopt(&bootPlayer, ui_Image1, done);
+    lv_obj_add_event_cb(ui_opening_screen, onScreenLoaded, LV_EVENT_SCREEN_LOADED, NULL);
+}
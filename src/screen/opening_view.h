@@ -0,0 +1,11 @@
+// File: src/screen/opening_view.h
+// Boot animation on the SquareLine opening screen. The generated handler
+// still starts its image set animation and the change to the home
+// screen; the frames are then played by an anim_player_t instead, which
+// only redraws when the frame changes. Call after ui_init() with
+// displayLock() held. done gets the frame counts once it has played.
+#pragma once
+
+#include "anim_player.h"
+
+void openingViewBegin(anim_player_done_cb done);
@@ -0,0 +1,36 @@
+// File: src/screen/prescale.cpp
+#include "prescale.h"
+
+static bool isAlphaOnly(const lv_img_dsc_t *img)
+{
+    lv_img_cf_t cf = (lv_img_cf_t)img->header.cf;
+    return cf == LV_IMG_CF_ALPHA_1BIT || cf == LV_IMG_CF_ALPHA_2BIT || cf == LV_IMG_CF_ALPHA_4BIT ||
+           cf == LV_IMG_CF_ALPHA_8BIT;
+}
+
+uint16_t prescaleApply(void)
+{
+    uint16_t fixed = 0;
+    for (uint16_t i = 0; i < prescale_fixup_count; i++)
+    {
+        const prescale_fixup_t *f = &prescale_fixups[i];
+        lv_obj_t *obj = *f->obj;
+        if (obj == NULL || !lv_obj_is_valid(obj))
+            continue;
+        if (lv_img_get_src(obj) != f->img || lv_img_get_zoom(obj) != f->designZoom)
+            continue;
+
+        if (f->designZoom != LV_IMG_ZOOM_NONE)
+        {
+            lv_img_set_zoom(obj, LV_IMG_ZOOM_NONE);
+            lv_obj_set_size(obj, LV_SIZE_CONTENT, LV_SIZE_CONTENT);
+            lv_obj_set_align(obj, LV_ALIGN_CENTER);
+            lv_obj_set_pos(obj, f->x, f->y);
+        }
+        // The alpha-only formats are drawn in the recolour colour
+        if (isAlphaOnly(f->img))
+            lv_obj_set_style_img_recolor(obj, lv_color_hex(f->recolor), LV_PART_MAIN | LV_STATE_DEFAULT);
+        fixed++;
+    }
+    return fixed;
+}
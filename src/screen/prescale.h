@@ -0,0 +1,40 @@
+// File: src/screen/prescale.h
+// Images the SquareLine screens draw scaled down are stored at their
+// drawn size by tools/prescale_assets.py (prescaled_assets.c), and every
+// image in the smallest exact colour format. The generated screens still
+// zoom them and lay them out for the full-size image; prescaleApply()
+// puts such objects back to zoom 256 at the place the zoomed image was
+// drawn, so LVGL copies the pixels instead of transforming them. Images
+// reduced to an alpha-only format get their colour as img_recolor.
+#pragma once
+
+#include <lvgl.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct prescale_fixup_t
+{
+    lv_obj_t **obj;          // SquareLine's global for the object
+    const lv_img_dsc_t *img; // the regenerated image it shows
+    uint16_t designZoom;     // zoom the screen sets, undone here
+    lv_coord_t x;            // offset from the centre of the screen
+    lv_coord_t y;
+    uint32_t recolor;        // 0xRRGGBB, used when img is LV_IMG_CF_ALPHA_<n>BIT
+} prescale_fixup_t;
+
+// From prescaled_assets.c
+extern const prescale_fixup_t prescale_fixups[];
+extern const uint16_t prescale_fixup_count;
+
+// Fixes every object that still has its design zoom. Call after
+// ui_init() and again whenever a screen has been built anew; objects
+// already fixed or deleted are left alone. Returns how many were fixed.
+// A screen that sets no zoom cannot tell it was fixed; its recolour is
+// simply set again.
+uint16_t prescaleApply(void);
+
+#ifdef __cplusplus
+}
+#endif
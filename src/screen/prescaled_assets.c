@@ -0,0 +1,174 @@
+// File: src/screen/prescaled_assets.c
+// Generated by tools/prescale_assets.py from src/screen/ui, do not edit.
+// Images at the size the screens draw them, in the smallest exact
+// colour format; the originals are left out of the build (platformio.ini).
+#include "prescale.h"
+#include "ui/ui.h"
+
+// 469x399 TRUE_COLOR_ALPHA at zoom 30 -> 55x47 INDEXED_8BIT
+static const uint8_t ui_img_batt_100_png_data[] = {
+    0x00,0x00,0x00,0x00,0xD6,0xD3,0xD6,0x01,0xE7,0xE7,0xE7,0x01,0xFF,0xFB,0xFF,0x01,0xFF,0xFF,0xFF,0x01,0xFF,0xFF,0xFF,0x02,
+    0xA5,0xA6,0x9C,0x03,0xD6,0xD3,0xD6,0x03,0xAD,0xBA,0x94,0x05,0xD6,0xD3,0xD6,0x05,0xD6,0xD7,0xD6,0x05,0xEF,0xEB,0xEF,0x05,
+    0xC6,0xCB,0xC6,0x06,0xCE,0xC7,0xCE,0x06,0xCE,0xCB,0xCE,0x06,0xCE,0xCF,0xCE,0x07,0xE7,0xE3,0xE7,0x0C,0x94,0xA6,0x7B,0x0D,
+    0x84,0xA2,0x63,0x0E,0xAD,0xB2,0xAD,0x0E,0xD6,0xD3,0xD6,0x0F,0x8C,0x96,0x73,0x11,0xA5,0xAE,0x9C,0x11,0x84,0x9A,0x73,0x15,
+    0xBD,0xBA,0xBD,0x15,0xE7,0xDF,0xE7,0x16,0xDE,0xDF,0xDE,0x17,0xE7,0xDF,0xE7,0x17,0x8C,0xAE,0x6B,0x1E,0xBD,0xBE,0xB5,0x21,
+    0xB5,0xC3,0xA5,0x22,0x84,0x9A,0x73,0x23,0x84,0xA6,0x5A,0x25,0x8C,0xA2,0x6B,0x26,0x8C,0x9A,0x7B,0x26,0xC6,0xC7,0xC6,0x29,
+    0x84,0xA6,0x5A,0x2C,0x8C,0xA6,0x6B,0x2D,0x84,0x9A,0x73,0x2E,0xA5,0xAE,0x94,0x2F,0x8C,0x96,0x73,0x30,0xBD,0xBA,0xB5,0x33,
+    0x7B,0xAE,0x4A,0x34,0x84,0xA2,0x63,0x35,0x8C,0x9E,0x73,0x35,0x8C,0xAA,0x6B,0x36,0xAD,0xBA,0xA5,0x37,0x9C,0xAA,0x8C,0x39,
+    0xBD,0xC3,0xB5,0x39,0xAD,0xC3,0x94,0x3A,0x9C,0xB6,0x7B,0x3B,0x84,0xB6,0x5A,0x41,0x7B,0x8E,0x6B,0x41,0x94,0xAA,0x6B,0x41,
+    0x94,0xAE,0x6B,0x42,0x84,0xAA,0x5A,0x43,0x84,0xB6,0x5A,0x43,0x8C,0xB6,0x5A,0x43,0x84,0xB6,0x5A,0x44,0x84,0x9A,0x63,0x47,
+    0x8C,0x9E,0x6B,0x48,0x7B,0xAE,0x4A,0x49,0x94,0xAA,0x6B,0x4A,0x8C,0xAE,0x6B,0x4A,0xAD,0xB6,0x9C,0x4A,0xB5,0xBA,0xA5,0x4A,
+    0x8C,0xA6,0x6B,0x4C,0x94,0xAA,0x7B,0x4C,0x8C,0xA6,0x6B,0x4D,0x8C,0x9E,0x63,0x4E,0x84,0xB2,0x52,0x4F,0x8C,0xA6,0x6B,0x4F,
+    0x7B,0x8E,0x6B,0x51,0x7B,0x92,0x6B,0x51,0x84,0x92,0x6B,0x51,0x8C,0xA2,0x6B,0x51,0x8C,0xA6,0x6B,0x51,0x84,0x92,0x6B,0x52,
+    0x8C,0xA6,0x6B,0x52,0x94,0xAE,0x7B,0x53,0x84,0xAA,0x5A,0x54,0x84,0xAE,0x5A,0x54,0x84,0xB6,0x42,0x5A,0x7B,0xB2,0x42,0x60,
+    0x9C,0xB2,0x84,0x66,0xAD,0xB2,0xAD,0x66,0xAD,0xB6,0xAD,0x66,0x9C,0xC3,0x73,0x67,0xA5,0xC3,0x73,0x67,0xA5,0xC3,0x7B,0x67,
+    0xAD,0xB2,0xA5,0x67,0x9C,0xBE,0x7B,0x68,0x84,0xB6,0x42,0x6D,0x7B,0xB2,0x42,0x73,0x8C,0xAA,0x63,0x78,0x9C,0xB2,0x84,0x7A,
+    0x7B,0xA2,0x5A,0x7B,0x7B,0xB6,0x42,0x7C,0x84,0xAA,0x52,0x7C,0x84,0xAA,0x52,0x7E,0x84,0xAA,0x5A,0x7E,0x9C,0xB6,0x84,0x7F,
+    0x9C,0xB6,0x73,0x81,0x9C,0xB6,0x7B,0x81,0x7B,0xB2,0x42,0x83,0x8C,0xAE,0x63,0x83,0x9C,0xBA,0x7B,0x86,0x9C,0xBA,0x7B,0x87,
+    0xA5,0xBA,0x84,0x87,0xA5,0xBA,0x7B,0x88,0xA5,0xBA,0x84,0x88,0x7B,0xB2,0x42,0x89,0x8C,0xAE,0x63,0x89,0x84,0xAE,0x52,0x8A,
+    0xA5,0xBA,0x84,0x8A,0x7B,0xA6,0x52,0x8B,0x84,0xA6,0x52,0x8B,0x84,0xAA,0x52,0x8B,0x84,0xAE,0x52,0x8B,0x84,0xA6,0x5A,0x8B,
+    0x84,0xAA,0x5A,0x8B,0xA5,0xBA,0x84,0x8D,0x7B,0xB2,0x42,0x8E,0xA5,0xBA,0x84,0x8E,0xA5,0xBA,0x84,0x8F,0x7B,0xB2,0x42,0x92,
+    0x7B,0xB6,0x42,0x92,0xA5,0xBA,0x84,0x93,0x7B,0xB6,0x39,0x94,0xA5,0xBA,0x84,0x96,0x7B,0xB2,0x42,0x99,0x7B,0xB2,0x42,0x9A,
+    0x7B,0xB2,0x42,0x9B,0x7B,0xB6,0x42,0x9B,0x7B,0xB6,0x42,0xA2,0x7B,0xB6,0x39,0xA3,0x7B,0xBA,0x39,0xA3,0x7B,0xB6,0x42,0xA3,
+    0x7B,0xB6,0x42,0xA4,0x7B,0xB2,0x39,0xB3,0x7B,0xB6,0x39,0xBE,0x7B,0xB6,0x42,0xBE,0x7B,0xB6,0x39,0xC2,0x7B,0xB2,0x42,0xC3,
+    0x7B,0xB2,0x42,0xC4,0x7B,0xB2,0x42,0xC5,0x7B,0xB2,0x42,0xCC,0x94,0xB6,0x73,0xCD,0x94,0xBA,0x73,0xCD,0x84,0xB2,0x52,0xDA,
+    0x7B,0xB6,0x39,0xDF,0x7B,0xB6,0x39,0xE0,0x7B,0xB6,0x39,0xE3,0x84,0xB6,0x4A,0xE9,0x7B,0xB2,0x42,0xEA,0x7B,0xB2,0x42,0xED,
+    0x7B,0xBA,0x39,0xEE,0x7B,0xB2,0x42,0xEE,0x7B,0xB6,0x39,0xEF,0x7B,0xB2,0x42,0xEF,0x84,0xB6,0x4A,0xF0,0x7B,0xB6,0x42,0xF1,
+    0x7B,0xB2,0x42,0xF3,0x7B,0xB6,0x39,0xF5,0x7B,0xBA,0x39,0xF6,0x7B,0xBA,0x39,0xF7,0x7B,0xB6,0x39,0xF9,0x7B,0xBA,0x39,0xF9,
+    0x7B,0xB6,0x39,0xFB,0x7B,0xB6,0x42,0xFB,0x7B,0xB6,0x39,0xFC,0x7B,0xBA,0x39,0xFC,0x7B,0xB6,0x39,0xFD,0x7B,0xBA,0x39,0xFD,
+    0x7B,0xBA,0x39,0xFE,0x7B,0xBA,0x39,0xFF,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    0x00,0x00,0x00,0x13,0x3C,0x45,0x45,0x45,0x45,0x45,0x45,0x45,0x45,0x45,0x45,0x45,0x45,0x45,0x45,0x45,0x45,0x45,0x45,0x45,
+    0x45,0x45,0x45,0x45,0x45,0x45,0x45,0x45,0x45,0x45,0x45,0x45,0x45,0x45,0x45,0x45,0x45,0x45,0x45,0x45,0x45,0x45,0x3B,0x15,
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x4F,0x9A,0xAF,0xAF,0xAF,0xAF,0xAF,0xAF,0xAF,0xAF,0xAF,0xAF,0xAF,0xAF,0xAF,
+    0xAF,0xAF,0xAF,0xAF,0xAF,0xAF,0xAF,0xAF,0xAF,0xAF,0xAF,0xAF,0xAF,0xAF,0xAF,0xAF,0xAF,0xAF,0xAF,0xAF,0xAF,0xAF,0xAF,0xAF,
+    0xAF,0xAF,0xAF,0xAF,0xAF,0xAF,0x9E,0x53,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x23,0xA2,0xAF,0xAD,0x9F,0x9D,0x9D,0x9D,0x9D,
+    0x9D,0x9D,0x9D,0x9D,0x9D,0x9D,0x9D,0x9D,0x9D,0x9D,0x9D,0x9D,0x9D,0x9D,0x9D,0x9D,0x9D,0x9D,0x9D,0x9D,0x9D,0x9D,0x9D,0x9D,
+    0x9D,0x9D,0x9D,0x9F,0x9F,0x9F,0x9F,0x9F,0x9F,0x9F,0x9F,0x9F,0xAC,0xAF,0xA5,0x2A,0x00,0x00,0x00,0x00,0x00,0x00,0x5F,0xAF,
+    0xA7,0x50,0x0D,0x0A,0x0A,0x09,0x09,0x09,0x09,0x09,0x09,0x09,0x09,0x09,0x09,0x09,0x09,0x09,0x09,0x0A,0x0A,0x09,0x09,0x09,
+    0x09,0x09,0x09,0x09,0x09,0x09,0x09,0x09,0x09,0x09,0x09,0x0E,0x0C,0x0C,0x0C,0x0C,0x0C,0x0C,0x0F,0x40,0x99,0xAF,0x6F,0x00,
+    0x00,0x00,0x00,0x00,0x00,0x67,0xAF,0x8E,0x02,0x00,0x16,0x22,0x28,0x2C,0x35,0x3E,0x25,0x18,0x4D,0x48,0x48,0x48,0x49,0x4A,
+    0x34,0x0B,0x43,0x4C,0x4C,0x4C,0x4C,0x4C,0x4E,0x11,0x2F,0x4B,0x44,0x42,0x42,0x42,0x47,0x21,0x1E,0x3F,0x36,0x2D,0x26,0x1F,
+    0x17,0x00,0x00,0x81,0xAF,0x80,0x00,0x00,0x00,0x00,0x00,0x00,0x67,0xAF,0x8D,0x00,0x2E,0xA1,0xAD,0xAD,0xAE,0xAE,0xAE,0x89,
+    0x5A,0xAF,0xAF,0xAF,0xAF,0xAF,0xAF,0x97,0x1B,0xA0,0xAF,0xAF,0xAF,0xAF,0xAF,0xAE,0x38,0x93,0xAF,0xAF,0xAF,0xAF,0xAF,0xAF,
+    0x61,0x5B,0xAE,0xAE,0xAE,0xAD,0xAD,0xA4,0x52,0x04,0x72,0xAF,0x80,0x00,0x00,0x00,0x00,0x00,0x00,0x67,0xAF,0x8D,0x00,0x6E,
+    0xAF,0xAF,0xAF,0xAF,0xAF,0xAF,0x86,0x5A,0xAF,0xAF,0xAF,0xAF,0xAF,0xAF,0x96,0x19,0xA0,0xAF,0xAF,0xAF,0xAF,0xAF,0xAE,0x39,
+    0x93,0xAF,0xAF,0xAF,0xAF,0xAF,0xAF,0x61,0x59,0xAF,0xAF,0xAF,0xAF,0xAF,0xAF,0x87,0x00,0x6B,0xAF,0x80,0x00,0x00,0x00,0x00,
+    0x00,0x00,0x67,0xAF,0x8D,0x00,0x7C,0xAF,0xAF,0xAF,0xAF,0xAF,0xAF,0x86,0x5A,0xAF,0xAF,0xAF,0xAF,0xAF,0xAF,0x96,0x1B,0xA0,
+    0xAF,0xAF,0xAF,0xAF,0xAF,0xAE,0x39,0x93,0xAF,0xAF,0xAF,0xAF,0xAF,0xAF,0x61,0x58,0xAF,0xAF,0xAF,0xAF,0xAF,0xAF,0x88,0x00,
+    0x6A,0xAF,0x80,0x00,0x00,0x00,0x00,0x00,0x00,0x67,0xAF,0x8D,0x00,0x7C,0xAF,0xAF,0xAF,0xAF,0xAF,0xAF,0x86,0x56,0xAF,0xAF,
+    0xAF,0xAF,0xAF,0xAF,0x96,0x1B,0xA0,0xAF,0xAF,0xAF,0xAF,0xAF,0xAE,0x39,0x94,0xAF,0xAF,0xAF,0xAF,0xAF,0xAF,0x61,0x57,0xAF,
+    0xAF,0xAF,0xAF,0xAF,0xAF,0x88,0x00,0x6D,0xAF,0x98,0x8B,0x7D,0x12,0x00,0x00,0x00,0x67,0xAF,0x8D,0x00,0x7C,0xAF,0xAF,0xAF,
+    0xAF,0xAF,0xAF,0x86,0x56,0xAF,0xAF,0xAF,0xAF,0xAF,0xAF,0x96,0x1B,0xA0,0xAF,0xAF,0xAF,0xAF,0xAF,0xAE,0x39,0x94,0xAF,0xAF,
+    0xAF,0xAF,0xAF,0xAF,0x61,0x57,0xAF,0xAF,0xAF,0xAF,0xAF,0xAF,0x88,0x00,0x6D,0xAF,0xAF,0xAF,0xAF,0x5D,0x00,0x00,0x00,0x67,
+    0xAF,0x8D,0x00,0x7C,0xAF,0xAF,0xAF,0xAF,0xAF,0xAF,0x86,0x56,0xAF,0xAF,0xAF,0xAF,0xAF,0xAF,0x96,0x1B,0xA0,0xAF,0xAF,0xAF,
+    0xAF,0xAF,0xAE,0x39,0x94,0xAF,0xAF,0xAF,0xAF,0xAF,0xAF,0x61,0x57,0xAF,0xAF,0xAF,0xAF,0xAF,0xAF,0x88,0x00,0x6D,0xAF,0xAF,
+    0xAF,0xAF,0x82,0x00,0x00,0x00,0x67,0xAF,0x8D,0x00,0x7C,0xAF,0xAF,0xAF,0xAF,0xAF,0xAF,0x86,0x56,0xAF,0xAF,0xAF,0xAF,0xAF,
+    0xAF,0x96,0x1B,0xA0,0xAF,0xAF,0xAF,0xAF,0xAF,0xAE,0x39,0x94,0xAF,0xAF,0xAF,0xAF,0xAF,0xAF,0x61,0x57,0xAF,0xAF,0xAF,0xAF,
+    0xAF,0xAF,0x88,0x00,0x6D,0xAF,0xAF,0xAF,0xAF,0x82,0x00,0x00,0x00,0x67,0xAF,0x8D,0x00,0x7C,0xAF,0xAF,0xAF,0xAF,0xAF,0xAF,
+    0x86,0x56,0xAF,0xAF,0xAF,0xAF,0xAF,0xAF,0x96,0x1B,0xA0,0xAF,0xAF,0xAF,0xAF,0xAF,0xAE,0x39,0x94,0xAF,0xAF,0xAF,0xAF,0xAF,
+    0xAF,0x61,0x57,0xAF,0xAF,0xAF,0xAF,0xAF,0xAF,0x88,0x00,0x6C,0xAF,0xAF,0xAF,0xAF,0x83,0x00,0x00,0x00,0x67,0xAF,0x8D,0x00,
+    0x7C,0xAF,0xAF,0xAF,0xAF,0xAF,0xAF,0x86,0x56,0xAF,0xAF,0xAF,0xAF,0xAF,0xAF,0x96,0x1B,0xA0,0xAF,0xAF,0xAF,0xAF,0xAF,0xAE,
+    0x39,0x94,0xAF,0xAF,0xAF,0xAF,0xAF,0xAF,0x61,0x57,0xAF,0xAF,0xAF,0xAF,0xAF,0xAF,0x88,0x00,0x6C,0xAF,0xAF,0xAF,0xAF,0x84,
+    0x00,0x00,0x00,0x67,0xAF,0x8D,0x00,0x7C,0xAF,0xAF,0xAF,0xAF,0xAF,0xAF,0x86,0x56,0xAF,0xAF,0xAF,0xAF,0xAF,0xAF,0x96,0x1B,
+    0xA0,0xAF,0xAF,0xAF,0xAF,0xAF,0xAE,0x39,0x94,0xAF,0xAF,0xAF,0xAF,0xAF,0xAF,0x61,0x57,0xAF,0xAF,0xAF,0xAF,0xAF,0xAF,0x88,
+    0x00,0x6C,0xAF,0xAF,0xAF,0xAF,0x84,0x00,0x00,0x00,0x67,0xAF,0x8D,0x00,0x7C,0xAF,0xAF,0xAF,0xAF,0xAF,0xAF,0x86,0x56,0xAF,
+    0xAF,0xAF,0xAF,0xAF,0xAF,0x96,0x1B,0xA0,0xAF,0xAF,0xAF,0xAF,0xAF,0xAE,0x39,0x94,0xAF,0xAF,0xAF,0xAF,0xAF,0xAF,0x61,0x57,
+    0xAF,0xAF,0xAF,0xAF,0xAF,0xAF,0x88,0x00,0x6C,0xAF,0xAF,0xAF,0xAF,0x84,0x00,0x00,0x00,0x67,0xAF,0x8D,0x00,0x7C,0xAF,0xAF,
+    0xAF,0xAF,0xAF,0xAF,0x86,0x56,0xAF,0xAF,0xAF,0xAF,0xAF,0xAF,0x96,0x1B,0xA0,0xAF,0xAF,0xAF,0xAF,0xAF,0xAE,0x39,0x94,0xAF,
+    0xAF,0xAF,0xAF,0xAF,0xAF,0x61,0x57,0xAF,0xAF,0xAF,0xAF,0xAF,0xAF,0x88,0x00,0x6C,0xAF,0xAF,0xAF,0xAF,0x84,0x00,0x00,0x00,
+    0x67,0xAF,0x8D,0x00,0x7C,0xAF,0xAF,0xAF,0xAF,0xAF,0xAF,0x86,0x56,0xAF,0xAF,0xAF,0xAF,0xAF,0xAF,0x96,0x1B,0xA0,0xAF,0xAF,
+    0xAF,0xAF,0xAF,0xAE,0x39,0x94,0xAF,0xAF,0xAF,0xAF,0xAF,0xAF,0x61,0x57,0xAF,0xAF,0xAF,0xAF,0xAF,0xAF,0x88,0x00,0x6C,0xAF,
+    0xAF,0xAF,0xAF,0x84,0x00,0x00,0x00,0x67,0xAF,0x8D,0x00,0x7C,0xAF,0xAF,0xAF,0xAF,0xAF,0xAF,0x86,0x56,0xAF,0xAF,0xAF,0xAF,
+    0xAF,0xAF,0x96,0x1B,0xA0,0xAF,0xAF,0xAF,0xAF,0xAF,0xAE,0x39,0x94,0xAF,0xAF,0xAF,0xAF,0xAF,0xAF,0x61,0x57,0xAF,0xAF,0xAF,
+    0xAF,0xAF,0xAF,0x88,0x00,0x6C,0xAF,0xAF,0xAF,0xAF,0x84,0x00,0x00,0x00,0x67,0xAF,0x8D,0x00,0x7C,0xAF,0xAF,0xAF,0xAF,0xAF,
+    0xAF,0x86,0x56,0xAF,0xAF,0xAF,0xAF,0xAF,0xAF,0x96,0x1B,0xA0,0xAF,0xAF,0xAF,0xAF,0xAF,0xAE,0x39,0x94,0xAF,0xAF,0xAF,0xAF,
+    0xAF,0xAF,0x61,0x57,0xAF,0xAF,0xAF,0xAF,0xAF,0xAF,0x88,0x00,0x6C,0xAF,0xAF,0xAF,0xAF,0x83,0x00,0x00,0x00,0x67,0xAF,0x8D,
+    0x00,0x7C,0xAF,0xAF,0xAF,0xAF,0xAF,0xAF,0x86,0x56,0xAF,0xAF,0xAF,0xAF,0xAF,0xAF,0x96,0x1B,0xA0,0xAF,0xAF,0xAF,0xAF,0xAF,
+    0xAE,0x39,0x94,0xAF,0xAF,0xAF,0xAF,0xAF,0xAF,0x61,0x57,0xAF,0xAF,0xAF,0xAF,0xAF,0xAF,0x88,0x00,0x6C,0xAF,0xAF,0xAF,0xAF,
+    0x68,0x00,0x00,0x00,0x67,0xAF,0x8D,0x00,0x7C,0xAF,0xAF,0xAF,0xAF,0xAF,0xAF,0x86,0x56,0xAF,0xAF,0xAF,0xAF,0xAF,0xAF,0x96,
+    0x1B,0xA0,0xAF,0xAF,0xAF,0xAF,0xAF,0xAE,0x39,0x94,0xAF,0xAF,0xAF,0xAF,0xAF,0xAF,0x61,0x57,0xAF,0xAF,0xAF,0xAF,0xAF,0xAF,
+    0x88,0x00,0x72,0xAF,0xA6,0x9B,0x92,0x20,0x00,0x00,0x00,0x67,0xAF,0x8D,0x00,0x7C,0xAF,0xAF,0xAF,0xAF,0xAF,0xAF,0x86,0x56,
+    0xAF,0xAF,0xAF,0xAF,0xAF,0xAF,0x96,0x1B,0xA0,0xAF,0xAF,0xAF,0xAF,0xAF,0xAE,0x39,0x94,0xAF,0xAF,0xAF,0xAF,0xAF,0xAF,0x61,
+    0x57,0xAF,0xAF,0xAF,0xAF,0xAF,0xAF,0x88,0x00,0x79,0xAF,0x85,0x14,0x07,0x00,0x00,0x00,0x00,0x67,0xAF,0x8D,0x00,0x7B,0xAF,
+    0xAF,0xAF,0xAF,0xAF,0xAF,0x89,0x5A,0xAF,0xAF,0xAF,0xAF,0xAF,0xAF,0x96,0x1B,0xA0,0xAF,0xAF,0xAF,0xAF,0xAF,0xAF,0x3A,0x94,
+    0xAF,0xAF,0xAF,0xAF,0xAF,0xAF,0x61,0x57,0xAF,0xAF,0xAF,0xAF,0xAF,0xAF,0x87,0x00,0x7C,0xAF,0x80,0x00,0x00,0x00,0x00,0x00,
+    0x00,0x67,0xAF,0x8D,0x00,0x41,0xAA,0xAF,0xAF,0xAF,0xAF,0xAF,0x8A,0x55,0xAF,0xAF,0xAF,0xAF,0xAF,0xAF,0x97,0x1A,0xA0,0xAF,
+    0xAF,0xAF,0xAF,0xAF,0xAE,0x33,0x93,0xAF,0xAF,0xAF,0xAF,0xAF,0xAF,0x61,0x57,0xAF,0xAF,0xAF,0xAF,0xAF,0xAE,0x5C,0x00,0x7C,
+    0xAF,0x80,0x00,0x00,0x00,0x00,0x00,0x00,0x67,0xAF,0x8C,0x00,0x03,0x32,0x70,0x78,0x75,0x74,0x74,0x51,0x29,0x73,0x77,0x77,
+    0x77,0x74,0x74,0x60,0x10,0x69,0x76,0x76,0x76,0x76,0x76,0x71,0x1C,0x54,0x77,0x74,0x77,0x77,0x77,0x74,0x37,0x31,0x75,0x75,
+    0x75,0x75,0x78,0x46,0x08,0x00,0x7F,0xAF,0x80,0x00,0x00,0x00,0x00,0x00,0x00,0x65,0xAF,0x9C,0x24,0x00,0x00,0x00,0x00,0x00,
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x1D,0x95,0xAF,0x7E,0x00,0x00,0x00,0x00,0x00,0x00,0x30,0xA9,
+    0xAF,0xA3,0x91,0x8F,0x8F,0x8F,0x8F,0x8F,0x8F,0x90,0x90,0x8F,0x8F,0x8F,0x8F,0x8F,0x8F,0x8F,0x8F,0x8F,0x8F,0x8F,0x8F,0x8F,
+    0x8F,0x8F,0x8F,0x90,0x90,0x8F,0x8F,0x8F,0x8F,0x8F,0x8F,0x8F,0x8F,0x8F,0x8F,0x8F,0x8F,0x8F,0x90,0xA2,0xAF,0xAD,0x3D,0x00,
+    0x00,0x00,0x00,0x00,0x00,0x05,0x66,0xA8,0xAF,0xAF,0xAF,0xAF,0xAF,0xAF,0xAF,0xAF,0xAF,0xAF,0xAF,0xAF,0xAF,0xAF,0xAF,0xAF,
+    0xAF,0xAF,0xAF,0xAF,0xAF,0xAF,0xAF,0xAF,0xAF,0xAF,0xAF,0xAF,0xAF,0xAF,0xAF,0xAF,0xAF,0xAF,0xAF,0xAF,0xAF,0xAF,0xAF,0xAF,
+    0xAF,0xAF,0xAF,0xAB,0x7A,0x06,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x04,0x27,0x5E,0x63,0x64,0x64,0x64,0x64,0x64,0x64,0x64,
+    0x64,0x64,0x64,0x64,0x64,0x64,0x64,0x64,0x64,0x64,0x64,0x64,0x64,0x64,0x64,0x64,0x64,0x64,0x64,0x64,0x64,0x64,0x64,0x64,
+    0x64,0x64,0x64,0x64,0x64,0x64,0x64,0x63,0x63,0x62,0x2B,0x01,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+};
+const lv_img_dsc_t ui_img_batt_100_png = {
+    .header.always_zero = 0,
+    .header.w = 55,
+    .header.h = 47,
+    .data_size = sizeof(ui_img_batt_100_png_data),
+    .header.cf = LV_IMG_CF_INDEXED_8BIT,
+    .data = ui_img_batt_100_png_data,
+};
+
+const prescale_fixup_t prescale_fixups[] = {
+    {&ui_Image3, &ui_img_batt_100_png, 30, 197, -112, 0x000000},
+};
+const uint16_t prescale_fixup_count = 1;
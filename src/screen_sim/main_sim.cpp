@@ -0,0 +1,339 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "anim_codec.h"
+#include "assets.h"
+#include "opening_view.h"
+#include "prescale.h"
+#include "sim_display.h"
+#include "sim_tick.h"
+#include "ui/ui.h"
+
+// --- SCREEN SIMULATOR ---
+// Runs the SquareLine UI headless on the host from a script:
+//   pio run -e screen-native && .pio/build/screen-native/program [--record] script.sim [outdir] [assets.bin]
+// The asset pack defaults to the one tools/pack_assets.py writes. With
+// --record every expect line is rewritten with the checksum of the frame
+// it sees, for a new baseline after an intended UI change.
+// Script commands, one per line, '#' starts a comment:
+//   init                     ui_init(), boot animation through the player
+//   build <screen>           (re)build a screen with its _screen_init()
+//   destroy <screen>         <screen>_screen_destroy()
+//   screen <screen>          load it, building it first if needed
+//   theme <n>                ui_theme_set(n)
+//   wait <ms>                advance the virtual clock, rendering as due
+//   press <x> <y> | release  pointer state, read every 30 ms by LVGL
+//   click <x> <y>            press, 100 ms, release, 100 ms
+//   drag <x1> <y1> <x2> <y2> <ms>
+//   shot <file>              frame buffer to .bmp (or .ppm) in outdir
+//   expect <crc32>           fail unless the frame buffer checksum matches,
+//                            a bare expect fails until recorded
+// <screen> is opening or home. Every command prints the wall time it
+// took, including rendering, so the numbers can be tracked in CI.
+
+#define SIM_LINE_MAX 160
+#define SIM_ASSETS_DEFAULT ".pio/assets/assets.bin"
+#define SIM_CLICK_MS 100
+#define SIM_DRAG_STEP_MS 10
+
+typedef struct sim_screen_t
+{
+    const char *name;
+    lv_obj_t **obj;
+    void (*init)(void);
+    void (*destroy)(void);
+} sim_screen_t;
+
+static const sim_screen_t screens[] = {
+    {"opening", &ui_opening_screen, ui_opening_screen_screen_init, ui_opening_screen_screen_destroy},
+    {"home", &ui_home_screen, ui_home_screen_screen_init, ui_home_screen_screen_destroy},
+};
+
+static const char *outDir = ".";
+static uint8_t *assetPack = NULL;
+static FILE *record = NULL; // script copy with the checksums filled in
+
+// The simulator's stand-in for the mapped asset partition
+static void loadAssets(const char *path)
+{
+    FILE *f = fopen(path, "rb");
+    long size = -1;
+    if (f != NULL && fseek(f, 0, SEEK_END) == 0)
+        size = ftell(f);
+    if (size > 0)
+    {
+        assetPack = (uint8_t *)malloc(size);
+        rewind(f);
+        if (assetPack == NULL || fread(assetPack, 1, size, f) != (size_t)size)
+            size = -1;
+    }
+    if (f != NULL)
+        fclose(f);
+
+    if (size <= 0)
+        printf("Assets: cannot read %s\n", path);
+    else if (!assetsOpen(assetPack, (uint32_t)size))
+        printf("Assets: %s\n", assetsError());
+    else
+        printf("Assets: %u entries, %u bytes from %s\n", assetsCount(), (unsigned)assetsSize(), path);
+}
+
+static void printBootAnim(const anim_player_t *p)
+{
+    printf("  boot animation: %u frames rendered, %u dropped, %u duplicated, max %u ms late\n",
+           (unsigned)p->rendered, (unsigned)p->dropped, (unsigned)p->duplicated, (unsigned)p->maxLateMs);
+}
+
+static const sim_screen_t *findScreen(const char *name)
+{
+    if (name == NULL)
+        return NULL;
+    for (size_t i = 0; i < sizeof(screens) / sizeof(screens[0]); i++)
+        if (strcmp(screens[i].name, name) == 0)
+            return &screens[i];
+    return NULL;
+}
+
+static bool parseInts(int *out, int count)
+{
+    for (int i = 0; i < count; i++)
+    {
+        const char *tok = strtok(NULL, " \t");
+        if (tok == NULL)
+            return false;
+        char *end;
+        out[i] = (int)strtol(tok, &end, 0);
+        if (*end != '\0')
+            return false;
+    }
+    return true;
+}
+
+static void drag(int x1, int y1, int x2, int y2, int ms)
+{
+    int steps = ms / SIM_DRAG_STEP_MS;
+    if (steps < 1)
+        steps = 1;
+    simPointer(x1, y1, true);
+    simRun(SIM_DRAG_STEP_MS);
+    for (int i = 1; i <= steps; i++)
+    {
+        simPointer(x1 + (x2 - x1) * i / steps, y1 + (y2 - y1) * i / steps, true);
+        simRun(SIM_DRAG_STEP_MS);
+    }
+    simPointer(x2, y2, false);
+    simRun(SIM_CLICK_MS);
+}
+
+// Runs one script line. False stops the script with an error.
+static bool runCommand(char *line, int lineNo)
+{
+    const char *cmd = strtok(line, " \t");
+    const char *arg = strtok(NULL, " \t");
+    int v[5];
+
+    if (strcmp(cmd, "init") == 0)
+    {
+        ui_init();
+        openingViewBegin(printBootAnim);
+        prescaleApply();
+    }
+    else if (strcmp(cmd, "build") == 0 || strcmp(cmd, "destroy") == 0 || strcmp(cmd, "screen") == 0)
+    {
+        const sim_screen_t *s = findScreen(arg);
+        if (s == NULL)
+        {
+            fprintf(stderr, "line %d: unknown screen\n", lineNo);
+            return false;
+        }
+        if (cmd[0] == 'b')
+        {
+            if (*s->obj != NULL)
+                s->destroy();
+            s->init();
+            prescaleApply();
+        }
+        else if (cmd[0] == 'd')
+            s->destroy();
+        else
+        {
+            if (*s->obj == NULL)
+                s->init();
+            prescaleApply();
+            lv_disp_load_scr(*s->obj);
+        }
+    }
+    else if (strcmp(cmd, "theme") == 0 && arg != NULL)
+        ui_theme_set((uint8_t)atoi(arg));
+    else if (strcmp(cmd, "wait") == 0 && arg != NULL)
+        simRun((uint32_t)atol(arg));
+    else if (strcmp(cmd, "release") == 0)
+    {
+        simPointer(0, 0, false);
+        simRun(1);
+    }
+    else if ((strcmp(cmd, "press") == 0 || strcmp(cmd, "click") == 0) && arg != NULL && parseInts(v + 1, 1))
+    {
+        v[0] = atoi(arg);
+        simPointer(v[0], v[1], true);
+        simRun(cmd[0] == 'c' ? SIM_CLICK_MS : 1);
+        if (cmd[0] == 'c')
+        {
+            simPointer(v[0], v[1], false);
+            simRun(SIM_CLICK_MS);
+        }
+    }
+    else if (strcmp(cmd, "drag") == 0 && arg != NULL && parseInts(v + 1, 4))
+        drag(atoi(arg), v[1], v[2], v[3], v[4]);
+    else if (strcmp(cmd, "shot") == 0 && arg != NULL)
+    {
+        char path[256];
+        snprintf(path, sizeof(path), "%s/%s", outDir, arg);
+        if (!simWriteImage(path))
+        {
+            fprintf(stderr, "line %d: cannot write %s\n", lineNo, path);
+            return false;
+        }
+        printf("  wrote %s (crc %08x)\n", path, (unsigned)simFrameCrc());
+    }
+    else if (strcmp(cmd, "expect") == 0)
+    {
+        uint32_t got = simFrameCrc();
+        if (record != NULL)
+            printf("  recorded crc %08x\n", (unsigned)got);
+        else if (arg == NULL)
+        {
+            fprintf(stderr, "line %d: no crc recorded, run with --record\n", lineNo);
+            return false;
+        }
+        else if (got != (uint32_t)strtoul(arg, NULL, 16))
+        {
+            fprintf(stderr, "line %d: frame crc %08x, expected %s\n", lineNo, (unsigned)got, arg);
+            return false;
+        }
+    }
+    else
+    {
+        fprintf(stderr, "line %d: bad command '%s'\n", lineNo, cmd);
+        return false;
+    }
+    return true;
+}
+
+// Copies a script line to the recording, the expect lines with the checksum
+// of the current frame and their comment kept
+static void recordLine(const char *raw, bool isExpect)
+{
+    if (!isExpect)
+    {
+        fputs(raw, record);
+        return;
+    }
+    const char *hash = strchr(raw, '#');
+    fprintf(record, "%.*sexpect %08x", (int)strspn(raw, " \t"), raw, (unsigned)simFrameCrc());
+    if (hash != NULL)
+        fprintf(record, "  %s", hash);
+    else
+        fputc('\n', record);
+}
+
+// Writes the recording over the script it was made from
+static bool saveRecord(const char *path)
+{
+    FILE *f = fopen(path, "w");
+    if (f == NULL)
+        return false;
+    rewind(record);
+    char buf[512];
+    size_t n;
+    while ((n = fread(buf, 1, sizeof(buf), record)) > 0)
+        fwrite(buf, 1, n, f);
+    return fclose(f) == 0;
+}
+
+int main(int argc, char **argv)
+{
+    const char *prog = argv[0];
+    if (argc > 1 && strcmp(argv[1], "--record") == 0)
+    {
+        record = tmpfile();
+        argv++;
+        argc--;
+    }
+    if (argc < 2 || (record != NULL && strcmp(argv[1], "-") == 0))
+    {
+        fprintf(stderr, "usage: %s [--record] <script|-> [outdir] [assets.bin]\n", prog);
+        return 2;
+    }
+    FILE *script = strcmp(argv[1], "-") == 0 ? stdin : fopen(argv[1], "r");
+    if (script == NULL)
+    {
+        fprintf(stderr, "cannot open %s\n", argv[1]);
+        return 2;
+    }
+    if (argc > 2)
+        outDir = argv[2];
+    loadAssets(argc > 3 ? argv[3] : SIM_ASSETS_DEFAULT);
+
+    simDisplayBegin();
+    if (!animCodecBegin())
+        printf("Boot animation frames missing from the asset pack\n");
+
+    char line[SIM_LINE_MAX];
+    char raw[SIM_LINE_MAX];
+    char echo[SIM_LINE_MAX];
+    int lineNo = 0;
+    uint64_t totalUs = 0;
+    while (fgets(line, sizeof(line), script) != NULL)
+    {
+        lineNo++;
+        strncpy(raw, line, sizeof(raw));
+        char *hash = strchr(line, '#');
+        if (hash != NULL)
+            *hash = '\0';
+        line[strcspn(line, "\r\n")] = '\0';
+        if (strspn(line, " \t") == strlen(line))
+        {
+            if (record != NULL)
+                recordLine(raw, false);
+            continue;
+        }
+        strncpy(echo, line + strspn(line, " \t"), sizeof(echo));
+        bool isExpect = strncmp(echo, "expect", 6) == 0 && strchr(" \t", echo[6]) != NULL;
+
+        sim_stats_t s;
+        simTakeStats(&s);
+        uint64_t start = simWallUs();
+        bool ok = runCommand(line, lineNo);
+        uint64_t us = simWallUs() - start;
+        totalUs += us;
+        if (!ok)
+            return 1;
+        if (record != NULL)
+            recordLine(raw, isExpect);
+
+        simTakeStats(&s);
+        printf("%7u ms  %-30s %9.3f ms wall, %u frames, %llu px, %u flushes\n", (unsigned)simTickMs(), echo,
+               us / 1000.0, (unsigned)s.frames, (unsigned long long)s.pixels, (unsigned)s.flushes);
+    }
+    if (record != NULL)
+    {
+        if (!saveRecord(argv[1]))
+        {
+            fprintf(stderr, "cannot write %s\n", argv[1]);
+            return 1;
+        }
+        printf("Recorded the frame checksums into %s\n", argv[1]);
+    }
+    printf("Total %.3f ms wall for %u ms of UI time\n", totalUs / 1000.0, (unsigned)simTickMs());
+
+    anim_codec_stats_t a;
+    animCodecTakeStats(&a);
+    if (a.frames > 0)
+        printf("Animation: %u frames decoded from %u tiles, avg %.3f ms, max %.3f ms, %u errors\n",
+               (unsigned)a.frames, (unsigned)a.tiles, a.decodeUs / 1000.0 / a.frames, a.maxUs / 1000.0,
+               (unsigned)a.errors);
+    if (a.shows > 0)
+        printf("Animation: %.0f px redrawn per frame change\n", (double)a.shownPx / a.shows);
+    return 0;
+}
@@ -0,0 +1,225 @@
+// File: src/screen_sim/sim_display.cpp
+#include "sim_display.h"
+#include "sim_tick.h"
+#include "board.h"
+#include <lvgl.h>
+#include <string.h>
+#include <time.h>
+
+#ifndef DISPLAY_BUF_LINES
+#define DISPLAY_BUF_LINES 40 // same default as the device, see display.h
+#endif
+
+#define DRAW_BUF_PIXELS (SCREEN_WIDTH * DISPLAY_BUF_LINES)
+
+static uint16_t framebuffer[SCREEN_WIDTH * SCREEN_HEIGHT];
+static lv_color_t drawPixels[DRAW_BUF_PIXELS];
+static lv_disp_draw_buf_t drawBuf;
+static lv_disp_drv_t dispDrv;
+static lv_indev_drv_t indevDrv;
+
+static int16_t pointerX = 0;
+static int16_t pointerY = 0;
+static bool pointerDown = false;
+
+static sim_stats_t stats;
+static uint32_t tickMs = 0;
+
+uint32_t simTickMs(void)
+{
+    return tickMs;
+}
+
+void simTickAdvance(uint32_t ms)
+{
+    tickMs += ms;
+}
+
+uint64_t simWallUs()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000ULL + ts.tv_nsec / 1000;
+}
+
+static void flushCb(lv_disp_drv_t *drv, const lv_area_t *area, lv_color_t *pixels)
+{
+    int32_t w = area->x2 - area->x1 + 1;
+    for (int32_t y = area->y1; y <= area->y2; y++)
+    {
+        memcpy(&framebuffer[y * SCREEN_WIDTH + area->x1], pixels, w * sizeof(uint16_t));
+        pixels += w;
+    }
+    stats.flushes++;
+    lv_disp_flush_ready(drv);
+}
+
+static void monitorCb(lv_disp_drv_t *drv, uint32_t timeMs, uint32_t pixels)
+{
+    (void)drv;
+    (void)timeMs; // virtual time, always 0 here; simRun() measures wall time
+    stats.frames++;
+    stats.pixels += pixels;
+}
+
+static void pointerCb(lv_indev_drv_t *drv, lv_indev_data_t *data)
+{
+    (void)drv;
+    data->point.x = pointerX;
+    data->point.y = pointerY;
+    data->state = pointerDown ? LV_INDEV_STATE_PRESSED : LV_INDEV_STATE_RELEASED;
+}
+
+void simDisplayBegin()
+{
+    lv_init();
+    lv_disp_draw_buf_init(&drawBuf, drawPixels, NULL, DRAW_BUF_PIXELS);
+    lv_disp_drv_init(&dispDrv);
+    dispDrv.hor_res = SCREEN_WIDTH;
+    dispDrv.ver_res = SCREEN_HEIGHT;
+    dispDrv.draw_buf = &drawBuf;
+    dispDrv.flush_cb = flushCb;
+    dispDrv.monitor_cb = monitorCb;
+    lv_disp_drv_register(&dispDrv);
+
+    lv_indev_drv_init(&indevDrv);
+    indevDrv.type = LV_INDEV_TYPE_POINTER;
+    indevDrv.read_cb = pointerCb;
+    lv_indev_drv_register(&indevDrv);
+}
+
+void simRun(uint32_t ms)
+{
+    uint32_t end = tickMs + ms;
+    for (;;)
+    {
+        uint64_t start = simWallUs();
+        uint32_t next = lv_timer_handler();
+        stats.handlerUs += simWallUs() - start;
+        stats.handlerCalls++;
+
+        uint32_t left = end - tickMs;
+        if ((int32_t)left <= 0)
+            break;
+        // Jump straight to the next timer that is due
+        if (next == 0)
+            next = 1;
+        simTickAdvance(next < left ? next : left);
+    }
+}
+
+void simPointer(int16_t x, int16_t y, bool pressed)
+{
+    pointerX = x;
+    pointerY = y;
+    pointerDown = pressed;
+}
+
+const uint16_t *simFramebuffer()
+{
+    return framebuffer;
+}
+
+uint32_t simFrameCrc()
+{
+    const uint8_t *p = (const uint8_t *)framebuffer;
+    uint32_t crc = 0xFFFFFFFF;
+    for (size_t i = 0; i < sizeof(framebuffer); i++)
+    {
+        crc ^= p[i];
+        for (int b = 0; b < 8; b++)
+            crc = (crc >> 1) ^ (0xEDB88320 & (0 - (crc & 1)));
+    }
+    return ~crc;
+}
+
+static void toRgb888(uint16_t c, uint8_t *rgb)
+{
+    uint8_t r = (c >> 11) & 0x1F;
+    uint8_t g = (c >> 5) & 0x3F;
+    uint8_t b = c & 0x1F;
+    rgb[0] = (r << 3) | (r >> 2);
+    rgb[1] = (g << 2) | (g >> 4);
+    rgb[2] = (b << 3) | (b >> 2);
+}
+
+static void put16(uint8_t *p, uint16_t v)
+{
+    p[0] = v & 0xFF;
+    p[1] = v >> 8;
+}
+
+static void put32(uint8_t *p, uint32_t v)
+{
+    put16(p, v & 0xFFFF);
+    put16(p + 2, v >> 16);
+}
+
+static bool writePpm(FILE *f)
+{
+    fprintf(f, "P6\n%d %d\n255\n", SCREEN_WIDTH, SCREEN_HEIGHT);
+    uint8_t row[SCREEN_WIDTH * 3];
+    for (int y = 0; y < SCREEN_HEIGHT; y++)
+    {
+        for (int x = 0; x < SCREEN_WIDTH; x++)
+            toRgb888(framebuffer[y * SCREEN_WIDTH + x], &row[x * 3]);
+        if (fwrite(row, sizeof(row), 1, f) != 1)
+            return false;
+    }
+    return true;
+}
+
+// 24-bit BGR, rows bottom-up. 480 * 3 is already a multiple of 4, so no
+// row padding.
+static bool writeBmp(FILE *f)
+{
+    const uint32_t rowBytes = SCREEN_WIDTH * 3;
+    const uint32_t dataBytes = rowBytes * SCREEN_HEIGHT;
+    uint8_t header[54];
+    memset(header, 0, sizeof(header));
+    header[0] = 'B';
+    header[1] = 'M';
+    put32(header + 2, sizeof(header) + dataBytes);
+    put32(header + 10, sizeof(header));
+    put32(header + 14, 40);
+    put32(header + 18, SCREEN_WIDTH);
+    put32(header + 22, SCREEN_HEIGHT);
+    put16(header + 26, 1);
+    put16(header + 28, 24);
+    put32(header + 34, dataBytes);
+    if (fwrite(header, sizeof(header), 1, f) != 1)
+        return false;
+
+    uint8_t row[SCREEN_WIDTH * 3];
+    for (int y = SCREEN_HEIGHT - 1; y >= 0; y--)
+    {
+        for (int x = 0; x < SCREEN_WIDTH; x++)
+        {
+            uint8_t rgb[3];
+            toRgb888(framebuffer[y * SCREEN_WIDTH + x], rgb);
+            row[x * 3] = rgb[2];
+            row[x * 3 + 1] = rgb[1];
+            row[x * 3 + 2] = rgb[0];
+        }
+        if (fwrite(row, sizeof(row), 1, f) != 1)
+            return false;
+    }
+    return true;
+}
+
+bool simWriteImage(const char *path)
+{
+    FILE *f = fopen(path, "wb");
+    if (f == NULL)
+        return false;
+    size_t len = strlen(path);
+    bool ppm = len > 4 && strcmp(path + len - 4, ".ppm") == 0;
+    bool ok = ppm ? writePpm(f) : writeBmp(f);
+    return fclose(f) == 0 && ok;
+}
+
+void simTakeStats(sim_stats_t *out)
+{
+    *out = stats;
+    memset(&stats, 0, sizeof(stats));
+}
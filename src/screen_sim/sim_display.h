@@ -0,0 +1,37 @@
+// File: src/screen_sim/sim_display.h
+// Headless LVGL display and pointer for the host simulator. LVGL renders
+// into a partial draw buffer the same size as on the device; the flush
+// copies it into an in-memory 480x272 RGB565 frame buffer, which can be
+// written out as an image or checksummed.
+#pragma once
+
+#include <stdint.h>
+#include <stdio.h>
+
+typedef struct sim_stats_t
+{
+    uint32_t handlerCalls;
+    uint64_t handlerUs; // wall time inside lv_timer_handler()
+    uint32_t frames;
+    uint32_t flushes;
+    uint64_t pixels;
+} sim_stats_t;
+
+void simDisplayBegin();
+
+// Runs lv_timer_handler() until the virtual clock moved on by ms
+void simRun(uint32_t ms);
+
+void simPointer(int16_t x, int16_t y, bool pressed);
+
+const uint16_t *simFramebuffer();
+uint32_t simFrameCrc();
+
+// .ppm gives a binary PPM, anything else a 24-bit BMP. False on I/O errors.
+bool simWriteImage(const char *path);
+
+// Counters since the last call, then resets
+void simTakeStats(sim_stats_t *out);
+
+// Monotonic wall clock, for timing what the script does
+uint64_t simWallUs();
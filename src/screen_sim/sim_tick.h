@@ -0,0 +1,18 @@
+// File: src/screen_sim/sim_tick.h
+// Virtual millisecond clock for the host simulator. LVGL reads it through
+// LV_TICK_CUSTOM (lv_conf.h); only the script moves it forward, so a run
+// renders the same frames no matter how fast the machine is.
+#pragma once
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+uint32_t simTickMs(void);
+void simTickAdvance(uint32_t ms);
+
+#ifdef __cplusplus
+}
+#endif
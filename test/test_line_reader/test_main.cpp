@@ -0,0 +1,141 @@
+// File: test/test_line_reader/test_main.cpp
+// Host tests for include/line_reader.h:
+//   pio test -e native
+#include <unity.h>
+#include <string>
+#include "line_reader.h"
+
+// Stands in for a serial port: bytes to read, and the echo written back
+struct fake_stream_t
+{
+    std::string in;
+    size_t pos = 0;
+    std::string out;
+
+    int available() { return (int)(in.size() - pos); }
+    int read() { return pos < in.size() ? (uint8_t)in[pos++] : -1; }
+    size_t write(uint8_t c)
+    {
+        out += (char)c;
+        return 1;
+    }
+};
+
+#define TEST_LINE_MAX 8
+#define TEST_HISTORY 3
+
+static line_reader_t<TEST_LINE_MAX, TEST_HISTORY> line;
+static fake_stream_t io;
+
+void setUp()
+{
+    lineReaderInit(&line, true);
+    io = fake_stream_t();
+}
+
+void tearDown() {}
+
+// Feeds text and returns the line completed by it, "" if none
+static std::string feed(const char *text)
+{
+    io.in += text;
+    const char *got = lineReaderPoll(&line, io, &io);
+    return got != NULL ? got : "";
+}
+
+static void test_plain_line()
+{
+    TEST_ASSERT_EQUAL_STRING("", feed("ab").c_str());
+    TEST_ASSERT_EQUAL_STRING("abc", feed("c\r").c_str());
+    TEST_ASSERT_EQUAL_STRING("abc\r\n", io.out.c_str());
+}
+
+static void test_line_endings()
+{
+    TEST_ASSERT_EQUAL_STRING("a", feed("a\r").c_str());
+    // The LF of a CR LF pair is not a second, empty line
+    TEST_ASSERT_EQUAL_STRING("b", feed("\nb\n").c_str());
+    TEST_ASSERT_EQUAL_STRING("c", feed("c\r\n").c_str());
+    TEST_ASSERT_EQUAL_STRING("d", feed("d\n").c_str());
+    TEST_ASSERT_EQUAL(0, io.available());
+}
+
+static void test_blank_lines_swallowed()
+{
+    TEST_ASSERT_EQUAL_STRING("x", feed("\r\n  \r\n x \r").c_str());
+}
+
+static void test_backspace_and_del()
+{
+    TEST_ASSERT_EQUAL_STRING("ac", feed("ab\bc\r").c_str());
+    TEST_ASSERT_EQUAL_STRING("ab", feed("abc\x7F\r").c_str());
+    // Nothing left to erase is not an error
+    TEST_ASSERT_EQUAL_STRING("z", feed("\b\x7Fz\r").c_str());
+}
+
+static void test_ctrl_u_clears()
+{
+    TEST_ASSERT_EQUAL_STRING("new", feed("old\x15new\r").c_str());
+}
+
+static void test_history_arrows()
+{
+    feed("one\r");
+    feed("two\r");
+    TEST_ASSERT_EQUAL_STRING("two", feed("\x1b[A\r").c_str());
+    TEST_ASSERT_EQUAL_STRING("one", feed("\x1b[A\x1b[A\r").c_str());
+    // "one" is the newest entry again; Down walks back towards it
+    TEST_ASSERT_EQUAL_STRING("two", feed("\x1b[A\x1b[A\x1b[A\x1b[B\r").c_str());
+}
+
+static void test_history_ctrl_keys()
+{
+    feed("one\r");
+    feed("two\r");
+    TEST_ASSERT_EQUAL_STRING("one", feed("\x10\x10\r").c_str());
+    TEST_ASSERT_EQUAL_STRING("two", feed("\x10\x10\x10\x0E\r").c_str());
+}
+
+static void test_history_keeps_typed_line()
+{
+    feed("one\r");
+    TEST_ASSERT_EQUAL_STRING("abc", feed("abc\x1b[A\x1b[B\r").c_str());
+    TEST_ASSERT_EQUAL_STRING("xy", feed("xy\x10\x0E\r").c_str());
+}
+
+static void test_history_bounded()
+{
+    feed("a\r");
+    feed("b\r");
+    feed("c\r");
+    feed("d\r");
+    // Only the last TEST_HISTORY lines are kept; Up stops at the oldest
+    TEST_ASSERT_EQUAL_STRING("b", feed("\x10\x10\x10\x10\r").c_str());
+}
+
+static void test_overflow_discards_line()
+{
+    TEST_ASSERT_EQUAL_STRING("", feed("0123456789\r").c_str());
+    TEST_ASSERT_NOT_NULL(strstr(io.out.c_str(), "too long"));
+    TEST_ASSERT_EQUAL(1, line.overflows);
+    // The next line is read normally
+    TEST_ASSERT_EQUAL_STRING("ok", feed("ok\r").c_str());
+    // Clearing the line starts over
+    TEST_ASSERT_EQUAL_STRING("short", feed("0123456789\x15short\r").c_str());
+}
+
+int main()
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_plain_line);
+    RUN_TEST(test_line_endings);
+    RUN_TEST(test_blank_lines_swallowed);
+    RUN_TEST(test_backspace_and_del);
+    RUN_TEST(test_ctrl_u_clears);
+    RUN_TEST(test_history_arrows);
+    RUN_TEST(test_history_ctrl_keys);
+    RUN_TEST(test_history_keeps_typed_line);
+    RUN_TEST(test_history_bounded);
+    RUN_TEST(test_overflow_discards_line);
+    return UNITY_END();
+}
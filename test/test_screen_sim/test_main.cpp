@@ -0,0 +1,32 @@
+// File: test/test_screen_sim/test_main.cpp
+// Replays src/screen_sim/boot.sim in the screen simulator, which fails on
+// the first frame whose checksum differs from its expect line:
+//   pio run -e screen-native && python3 tools/pack_assets.py && pio test -e native
+#include <unity.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#define SIM_PROGRAM ".pio/build/screen-native/program"
+#define SIM_SCRIPT "src/screen_sim/boot.sim"
+#define SIM_OUT_DIR ".pio/build/screen-native"
+
+void setUp() {}
+
+void tearDown() {}
+
+static void test_boot_frames()
+{
+    FILE *f = fopen(SIM_PROGRAM, "rb");
+    if (f == NULL)
+        TEST_IGNORE_MESSAGE("simulator not built, run pio run -e screen-native");
+    fclose(f);
+    TEST_ASSERT_EQUAL_MESSAGE(0, system(SIM_PROGRAM " " SIM_SCRIPT " " SIM_OUT_DIR),
+                              "frame changed, see the simulator output");
+}
+
+int main()
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_boot_frames);
+    return UNITY_END();
+}
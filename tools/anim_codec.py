@@ -0,0 +1,178 @@
+# File: tools/anim_codec.py
+# Tile encoder for the SquareLine image sets (the boot animation),
+# decoded on the screen by src/screen/anim_codec.cpp. Used by
+# tools/pack_assets.py, which puts the result into the asset partition.
+#
+# Frames are cut into 16x16 tiles (edge tiles padded with 0). Identical
+# tiles, in any frame of the set, are stored once in the clip's tile
+# store; a frame is only the map of tile ids, row by row. The screen
+# redraws just the tiles whose id differs from the frame shown before.
+#
+# Tile store, little endian:
+#   uint32 count, uint32 offset[count + 1] from the start of the store,
+#   then one stream per tile
+# Tile stream, RGB565 little endian, one op per byte:
+#   bits 7-6  op: 1 = RUN  (one colour follows, repeated)
+#                 2 = COPY (n colours follow)
+#   bits 5-0  n, 1..63; 0 means a 16-bit n follows
+# Frame: uint16 tile id per tile, ceil(w / 16) * ceil(h / 16) of them.
+
+import os
+import re
+import struct
+import sys
+
+TILE = 16
+OP_RUN, OP_COPY = 1, 2
+MAX_RUN = 0xFFFF
+MIN_RUN = 3  # shorter runs are cheaper as part of a COPY
+MAX_TILES = 0xFFFF
+
+IMGSET_RE = re.compile(r"const\s+lv_img_dsc_t\s*\*\s*(ui_imgset_\w+)\s*\[\d+\]\s*=\s*\{([^}]*)\}")
+
+
+def read_image(ui_dir, name):
+    """Pixels of a generated ui_img_*.c as RGB565 values, plus width/height."""
+    text = open(os.path.join(ui_dir, name + ".c")).read()
+    start = text.index(name + "_data[] = {")
+    body = text[start:text.index("};", start)]
+    data = bytes(int(h, 16) for h in re.findall(r"0x([0-9A-Fa-f]{2})", body))
+    w = int(re.search(r"\.header\.w\s*=\s*(\d+)", text).group(1))
+    h = int(re.search(r"\.header\.h\s*=\s*(\d+)", text).group(1))
+    if "LV_IMG_CF_TRUE_COLOR," not in text or len(data) != w * h * 2:
+        sys.exit("%s: expected %dx%d LV_IMG_CF_TRUE_COLOR data" % (name, w, h))
+    return list(struct.unpack("<%dH" % (w * h), data)), w, h
+
+
+def put_op(out, op, n):
+    if n < 64:
+        out.append((op << 6) | n)
+    else:
+        out.append(op << 6)
+        out += struct.pack("<H", n)
+
+
+def encode(pixels):
+    """RUN/COPY ops for one tile."""
+    out = bytearray()
+    n = len(pixels)
+    i = 0
+    while i < n:
+        j = i
+        while j < n and j - i < MAX_RUN and pixels[j] == pixels[i]:
+            j += 1
+        if j - i >= MIN_RUN:
+            put_op(out, OP_RUN, j - i)
+            out += struct.pack("<H", pixels[i])
+        else:
+            # Literal until a run starts
+            j = i
+            while j < n and j - i < MAX_RUN:
+                if j + MIN_RUN <= n and pixels[j] == pixels[j + 1] == pixels[j + 2]:
+                    break
+                j += 1
+            j = max(j, i + 1)
+            put_op(out, OP_COPY, j - i)
+            out += struct.pack("<%dH" % (j - i), *pixels[i:j])
+        i = j
+    return bytes(out)
+
+
+def decode(stream):
+    """Reference decoder, used to check every tile before it is written."""
+    out = []
+    p = 0
+    while p < len(stream):
+        op, n = stream[p] >> 6, stream[p] & 0x3F
+        p += 1
+        if n == 0:
+            n = stream[p] | (stream[p + 1] << 8)
+            p += 2
+        if op == OP_RUN:
+            out += [stream[p] | (stream[p + 1] << 8)] * n
+            p += 2
+        elif op == OP_COPY:
+            out += struct.unpack_from("<%dH" % n, stream, p)
+            p += 2 * n
+        else:
+            return None
+    return out
+
+
+def cut(pixels, w, h):
+    """The frame's tiles, row by row, each a tuple of TILE * TILE pixels."""
+    tiles = []
+    for ty in range(0, h, TILE):
+        for tx in range(0, w, TILE):
+            tile = []
+            for y in range(ty, ty + TILE):
+                row = pixels[y * w + tx:y * w + min(w, tx + TILE)] if y < h else []
+                tile += row + [0] * (TILE - len(row))
+            tiles.append(tuple(tile))
+    return tiles
+
+
+def tile_store(streams):
+    head = struct.pack("<I", len(streams))
+    offset = 4 + 4 * (len(streams) + 1)
+    offsets = []
+    for s in streams:
+        offsets.append(offset)
+        offset += len(s)
+    offsets.append(offset)
+    return head + struct.pack("<%dI" % len(offsets), *offsets) + b"".join(streams)
+
+
+def encode_sets(ui_dir):
+    """Encodes every image set in ui.c. Returns one dict per set with the
+    clip name, frame size, tile store and (name, tile map, changed tiles)
+    per frame."""
+    imgsets = IMGSET_RE.findall(open(os.path.join(ui_dir, "ui.c")).read())
+    if not imgsets:
+        sys.exit("no image sets in %s/ui.c" % ui_dir)
+
+    covered = set()
+    clips = []
+    for set_name, members in imgsets:
+        names = [m.strip().lstrip("&") for m in members.split(",") if m.strip()]
+        ids = {}
+        streams = []
+        frames = []
+        prev = None
+        size = None
+        print("%s: %d frames" % (set_name, len(names)))
+        for index, name in enumerate(names):
+            pixels, w, h = read_image(ui_dir, name)
+            if size is not None and (w, h) != size:
+                sys.exit("%s: frames of %s differ in size" % (name, set_name))
+            size = (w, h)
+
+            tiles = cut(pixels, w, h)
+            new = 0
+            for t in tiles:
+                if t not in ids:
+                    stream = encode(t)
+                    if decode(stream) != list(t):
+                        sys.exit("%s: tile does not decode back" % name)
+                    ids[t] = len(streams)
+                    streams.append(stream)
+                    new += 1
+            if len(streams) > MAX_TILES:
+                sys.exit("%s: more than %d distinct tiles" % (set_name, MAX_TILES))
+            tile_map = [ids[t] for t in tiles]
+            changed = len(tile_map) if prev is None else sum(a != b for a, b in zip(tile_map, prev))
+            frames.append((name, struct.pack("<%dH" % len(tile_map), *tile_map), changed))
+            prev = tile_map
+            covered.add(name)
+            print("  %2d %-18s %3d/%d tiles changed, %3d new" % (index, name, changed, len(tile_map), new))
+
+        store = tile_store(streams)
+        print("  %d distinct tiles, %d bytes" % (len(streams), len(store)))
+        clips.append({"set": set_name, "clip": "anim_" + set_name[len("ui_imgset_"):], "w": size[0], "h": size[1],
+                      "tiles": store, "frames": frames})
+
+    stray = [f[:-2] for f in os.listdir(ui_dir) if re.match(r"ui_img_\d+\.c$", f) and f[:-2] not in covered]
+    if stray:
+        # platformio.ini drops every ui_img_<number>.c from the build
+        sys.exit("images outside any image set would not be linked: %s" % ", ".join(sorted(stray)))
+    return clips
@@ -0,0 +1,86 @@
+# File: tools/img_formats.py
+# Picks the smallest LVGL colour format that stores an RGB565 image
+# without changing a single drawn pixel, and encodes it:
+#   INDEXED_1/2/4/8BIT  palette of (colour, alpha) pairs, 32-bit entries
+#   ALPHA_1/2/4/8BIT    one colour, drawn with the object's img_recolor
+#   TRUE_COLOR(_ALPHA)  when nothing smaller is exact
+# Fully transparent pixels count as one entry whatever their colour.
+# Rows of the packed formats start on a byte, most significant bits first,
+# as LVGL's built-in decoder reads them.
+
+import struct
+
+BYTES = {"LV_IMG_CF_TRUE_COLOR": 2, "LV_IMG_CF_TRUE_COLOR_ALPHA": 3}
+
+# Opacity LVGL gives each value of the ALPHA_<n>BIT formats
+ALPHA_LEVELS = {1: [0, 255], 2: [0, 85, 170, 255], 4: [v * 17 for v in range(16)], 8: list(range(256))}
+
+
+def decode(data, cf):
+    """(rgb565, alpha) per pixel of a TRUE_COLOR or TRUE_COLOR_ALPHA blob"""
+    bpp = BYTES[cf]
+    return [(data[i] | (data[i + 1] << 8), data[i + 2] if bpp == 3 else 255) for i in range(0, len(data), bpp)]
+
+
+def expand565(c):
+    r, g, b = (c >> 11) & 0x1F, (c >> 5) & 0x3F, c & 0x1F
+    return (r << 3) | (r >> 2), (g << 2) | (g >> 4), (b << 3) | (b >> 2)
+
+
+def pack(values, bits, w):
+    """Rows of `bits`-wide values, each row padded to a whole byte"""
+    out = bytearray()
+    for y in range(0, len(values), w):
+        acc, n = 0, 0
+        for v in values[y:y + w]:
+            acc = (acc << bits) | v
+            n += bits
+            if n == 8:
+                out.append(acc)
+                acc, n = 0, 0
+        if n:
+            out.append(acc << (8 - n))
+    return bytes(out)
+
+
+def candidates(pixels, w):
+    """(cf, data, recolor) for every format that holds the image exactly"""
+    pixels = [(c, a) if a else (0, 0) for c, a in pixels]
+    opaque = all(a == 255 for _, a in pixels)
+    out = []
+
+    true_cf = "LV_IMG_CF_TRUE_COLOR" if opaque else "LV_IMG_CF_TRUE_COLOR_ALPHA"
+    true_data = bytearray()
+    for c, a in pixels:
+        true_data += struct.pack("<H", c)
+        if not opaque:
+            true_data.append(a)
+    out.append((true_cf, bytes(true_data), None))
+
+    palette = sorted(set(pixels), key=lambda p: (p[1], p[0]))
+    for bits in (1, 2, 4, 8):
+        if len(palette) <= 1 << bits:
+            index = {p: i for i, p in enumerate(palette)}
+            head = bytearray()
+            for i in range(1 << bits):
+                c, a = palette[i] if i < len(palette) else (0, 0)
+                r, g, b = expand565(c)
+                head += bytes((b, g, r, a)) # lv_color32_t
+            out.append(("LV_IMG_CF_INDEXED_%dBIT" % bits, bytes(head) + pack([index[p] for p in pixels], bits, w),
+                        None))
+            break
+
+    colours = {c for c, a in pixels if a}
+    if len(colours) <= 1:
+        for bits in (1, 2, 4, 8):
+            levels = ALPHA_LEVELS[bits]
+            if all(a in levels for _, a in pixels):
+                out.append(("LV_IMG_CF_ALPHA_%dBIT" % bits, pack([levels.index(a) for _, a in pixels], bits, w),
+                            colours.pop() if colours else 0))
+                break
+    return out
+
+
+def smallest(pixels, w):
+    """(cf, data, recolor): recolor is the RGB565 colour for ALPHA formats, else None"""
+    return min(candidates(pixels, w), key=lambda c: len(c[1]))
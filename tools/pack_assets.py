@@ -0,0 +1,152 @@
+#!/usr/bin/env python3
+# File: tools/pack_assets.py
+# Builds the screen's asset partition image and the matching frame
+# descriptors, then prints how to flash the image:
+#   python3 tools/pack_assets.py
+# Writes .pio/assets/assets.bin and src/screen/anim_frames.c. The
+# firmware only needs rebuilding when the set of frames changes;
+# re-encoded pixels just need the partition flashed again.
+#
+# Partition layout, little endian, see src/screen/assets.h:
+#   header  magic "TGA1", version, entry count, pack size, CRC-32 of
+#           everything after the header
+#   table   one 40-byte entry per asset: name[24], offset, size, w, h,
+#           cf, flags, reserved
+#   blobs   4-byte aligned
+# Each image set gets a tile store entry, "tiles_<set id>", flagged
+# TILES, and one tile map entry per frame under the frame's name; the
+# formats are in tools/anim_codec.py.
+
+import argparse
+import csv
+import os
+import struct
+import sys
+import zlib
+
+sys.path.insert(0, os.path.dirname(os.path.abspath(__file__)))
+import anim_codec  # noqa: E402
+
+ASSET_MAGIC = 0x31414754  # "TGA1"
+ASSET_VERSION = 2
+ASSET_NAME_MAX = 24
+ASSET_FLAG_TILES = 0x02
+ASSET_ALIGN = 4
+HEADER = struct.Struct("<IHHII")
+ENTRY = struct.Struct("<24sIIHHBBH")
+CF_USER_ENCODED_0 = 0x18
+PARTITION_LABEL = "assets"
+
+
+def build_pack(entries):
+    """entries: (name, w, h, cf, flags, blob). Returns the partition image."""
+    table = bytearray()
+    blobs = bytearray()
+    data_start = HEADER.size + ENTRY.size * len(entries)
+    for name, w, h, cf, flags, blob in entries:
+        if len(name) >= ASSET_NAME_MAX:
+            sys.exit("asset name too long: %s" % name)
+        while (data_start + len(blobs)) % ASSET_ALIGN:
+            blobs.append(0)
+        table += ENTRY.pack(name.encode(), data_start + len(blobs), len(blob), w, h, cf, flags, 0)
+        blobs += blob
+    body = bytes(table + blobs)
+    return HEADER.pack(ASSET_MAGIC, ASSET_VERSION, len(entries), HEADER.size + len(body), zlib.crc32(body)) + body
+
+
+def find_partition(csv_path):
+    """(offset, size) of the assets partition in the partition table."""
+    with open(csv_path) as f:
+        rows = [r for r in csv.reader(f) if r and not r[0].lstrip().startswith("#")]
+    for row in rows:
+        cells = [c.strip() for c in row]
+        if cells[0] == PARTITION_LABEL:
+            return int(cells[3], 0), int(cells[4], 0)
+    sys.exit("no '%s' partition in %s" % (PARTITION_LABEL, csv_path))
+
+
+def tiles_name(clip):
+    return "tiles_" + clip["clip"][len("anim_"):]
+
+
+def write_frames_c(path, ui_dir, clips):
+    out = []
+    out.append("// File: src/screen/anim_frames.c")
+    out.append("// Generated by tools/pack_assets.py from %s, do not edit." % ui_dir)
+    out.append("// The descriptors keep SquareLine's names so the image sets in ui.c")
+    out.append("// link against these instead of the raw ui_img_<number>.c arrays.")
+    out.append("// The tile maps and tiles are in the asset partition, found by name.")
+    out.append('#include "anim_codec.h"')
+    out.append("")
+    for c in clips:
+        clip, frames = c["clip"], c["frames"]
+        out.append("// --- %s ---" % c["set"])
+        out.append("static const char *const %s_names[] = {" % clip)
+        out += ['    "%s",' % name for name, _, _ in frames]
+        out.append("};")
+        out.append("static const asset_entry_t *%s_entries[%d];" % (clip, len(frames)))
+        out.append('anim_clip_t %s = {%d, %d, %d, %s_names, %s_entries, "%s", NULL, false};' %
+                   (clip, c["w"], c["h"], len(frames), clip, clip, tiles_name(c)))
+        out.append("static const anim_frame_t %s_frames[] = {" % clip)
+        out += ["    {ANIM_FRAME_MAGIC, &%s, %d}," % (clip, i) for i in range(len(frames))]
+        out.append("};")
+        out.append("")
+        for i, (name, _, _) in enumerate(frames):
+            out.append("const lv_img_dsc_t %s = {" % name)
+            out.append("    .header.always_zero = 0,")
+            out.append("    .header.w = %d," % c["w"])
+            out.append("    .header.h = %d," % c["h"])
+            out.append("    .data_size = sizeof(anim_frame_t),")
+            out.append("    .header.cf = LV_IMG_CF_USER_ENCODED_0,")
+            out.append("    .data = (const uint8_t *)&%s_frames[%d]," % (clip, i))
+            out.append("};")
+        out.append("")
+    out.append("anim_clip_t *const anim_clips[] = {")
+    out += ["    &%s," % c["clip"] for c in clips]
+    out.append("};")
+    out.append("const uint16_t anim_clip_count = %d;" % len(clips))
+    out.append("")
+    with open(path, "w") as f:
+        f.write("\n".join(out))
+
+
+def main():
+    ap = argparse.ArgumentParser(description="Build the screen asset partition image")
+    ap.add_argument("--ui", default="src/screen/ui", help="SquareLine export directory")
+    ap.add_argument("--out", default=".pio/assets/assets.bin")
+    ap.add_argument("--frames-c", default="src/screen/anim_frames.c")
+    ap.add_argument("--partitions", default="partitions_screen.csv")
+    args = ap.parse_args()
+
+    clips = anim_codec.encode_sets(args.ui)
+    entries = []
+    raw = 0
+    for c in clips:
+        tile = anim_codec.TILE
+        entries.append((tiles_name(c), tile, tile, CF_USER_ENCODED_0, ASSET_FLAG_TILES, c["tiles"]))
+        for name, tile_map, _ in c["frames"]:
+            entries.append((name, c["w"], c["h"], CF_USER_ENCODED_0, 0, tile_map))
+            raw += c["w"] * c["h"] * 2
+        tiles = len(c["frames"][0][1]) // 2
+        changed = sum(f[2] for f in c["frames"][1:])
+        print("%s: %.0f of %d tiles redrawn per frame on average" %
+              (c["clip"], changed / max(1, len(c["frames"]) - 1), tiles))
+
+    pack = build_pack(entries)
+    offset, size = find_partition(args.partitions)
+    if len(pack) > size:
+        sys.exit("pack is %d bytes, the '%s' partition only %d" % (len(pack), PARTITION_LABEL, size))
+
+    os.makedirs(os.path.dirname(args.out) or ".", exist_ok=True)
+    with open(args.out, "wb") as f:
+        f.write(pack)
+    write_frames_c(args.frames_c, args.ui, clips)
+
+    print("%d assets, %d bytes from %d raw (%.1fx), %.0f%% of the %d KB partition" %
+          (len(entries), len(pack), raw, raw / len(pack), 100.0 * len(pack) / size, size // 1024))
+    print("Flash with:")
+    print("  pio pkg exec -p tool-esptoolpy -- esptool.py --chip esp32s3 write_flash 0x%x %s" % (offset, args.out))
+
+
+if __name__ == "__main__":
+    main()
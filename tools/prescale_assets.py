@@ -0,0 +1,270 @@
+#!/usr/bin/env python3
+# File: tools/prescale_assets.py
+# Regenerates the still images of the SquareLine screens the way they are
+# drawn, so the screen stores fewer bytes and draws them more cheaply:
+#   python3 tools/prescale_assets.py
+# Images only ever shown scaled down (lv_img_set_zoom < 256) are stored
+# pre-scaled to the size they are drawn at, so there is no software zoom
+# on every draw. Every image is then stored in the smallest colour format
+# that is exact (tools/img_formats.py); alpha-only formats are drawn in
+# the object's img_recolor.
+# Writes src/screen/prescaled_assets.c: the new descriptors under the
+# SquareLine names, and the zoom/position/recolour fixups
+# src/screen/prescale.cpp applies once the screens are built. The
+# original ui_img_*.c must be dropped from the build in platformio.ini;
+# the tool checks that. Ends with the flash budget of every image, and
+# for the pre-scaled ones the pixels a draw no longer zooms. That pixel
+# count stands in for draw time, which is not measured here: time the
+# screens with the screen-native simulator (src/screen_sim/boot.sim).
+#
+# Only objects aligned LV_ALIGN_CENTER directly on a screen, without
+# rotation or a custom pivot, are handled; anything else is reported
+# and left alone.
+
+import argparse
+import glob
+import os
+import re
+import sys
+
+from img_formats import BYTES, decode, expand565, smallest
+
+IMG_RE = re.compile(r"ui_img_\w+")
+CALL_RE = re.compile(r"^\s*(lv_\w+)\((\w+)(?:,\s*(.*?))?\);")
+CREATE_RE = re.compile(r"^\s*(\w+) = (lv_\w+_create)\((\w+)\);")
+
+
+def parse_screens(ui_dir):
+    """Image objects with the calls that matter for their geometry."""
+    objects = {}
+    screens = set()
+    for path in sorted(glob.glob(os.path.join(ui_dir, "ui_*_screen.c"))):
+        for line in open(path):
+            m = CREATE_RE.match(line)
+            if m:
+                name, kind, parent = m.groups()
+                if kind == "lv_obj_create" and parent == "NULL":
+                    screens.add(name)
+                elif kind == "lv_img_create":
+                    objects[name] = {"parent": parent, "file": os.path.basename(path)}
+                continue
+            m = CALL_RE.match(line)
+            if m and m.group(2) in objects:
+                objects[m.group(2)][m.group(1)] = (m.group(3) or "").strip()
+    for obj in objects.values():
+        obj["on_screen"] = obj["parent"] in screens
+    return objects
+
+
+def read_image(ui_dir, name):
+    text = open(os.path.join(ui_dir, name + ".c")).read()
+    start = text.index(name + "_data[] = {")
+    body = text[start:text.index("};", start)]
+    data = bytes(int(h, 16) for h in re.findall(r"0x([0-9A-Fa-f]{2})", body))
+    w = int(re.search(r"\.header\.w\s*=\s*(\d+)", text).group(1))
+    h = int(re.search(r"\.header\.h\s*=\s*(\d+)", text).group(1))
+    cf = re.search(r"\.header\.cf\s*=\s*(\w+)", text).group(1)
+    if cf not in BYTES or len(data) != w * h * BYTES[cf]:
+        return None
+    return data, w, h, cf
+
+
+def rgb888_to_565(r, g, b):
+    return ((int(r + 0.5) >> 3) << 11) | ((int(g + 0.5) >> 2) << 5) | (int(b + 0.5) >> 3)
+
+
+def resample(pixels, w, h, dw, dh):
+    """Area-average downscale, colours weighted by alpha."""
+    if (dw, dh) == (w, h):
+        return pixels
+    px = [expand565(c) + (a,) for c, a in pixels]
+
+    sx, sy = w / dw, h / dh
+    out = []
+    for oy in range(dh):
+        y0, y1 = oy * sy, (oy + 1) * sy
+        for ox in range(dw):
+            x0, x1 = ox * sx, (ox + 1) * sx
+            acc = [0.0, 0.0, 0.0, 0.0]
+            area = 0.0
+            for y in range(int(y0), min(h, int(y1 + 0.999999))):
+                wy = min(y1, y + 1) - max(y0, y)
+                for x in range(int(x0), min(w, int(x1 + 0.999999))):
+                    wgt = wy * (min(x1, x + 1) - max(x0, x))
+                    r, g, b, a = px[y * w + x]
+                    acc[0] += r * a * wgt
+                    acc[1] += g * a * wgt
+                    acc[2] += b * a * wgt
+                    acc[3] += a * wgt
+                    area += wgt
+            colour = rgb888_to_565(*(v / acc[3] for v in acc[:3])) if acc[3] > 0 else 0
+            out.append((colour, int(acc[3] / area + 0.5)))
+    return out
+
+
+def axis(size_expr, design, parent):
+    """Object extent along one axis from its width/height call."""
+    m = re.match(r"lv_pct\((\d+)\)$", size_expr or "")
+    if m:
+        return parent * int(m.group(1)) // 100
+    if size_expr in (None, "", "LV_SIZE_CONTENT"):
+        return design
+    return int(size_expr)
+
+
+def c_div(a, b):
+    """Integer division truncating towards zero, as LVGL's C does"""
+    q = abs(a) // abs(b)
+    return q if (a >= 0) == (b > 0) else -q
+
+
+def plan(objects, imgset_members, ui_dir, screen_w, screen_h):
+    """One entry per image to regenerate, plus reasons for the skipped ones."""
+    users = {}
+    for name, obj in objects.items():
+        src = obj.get("lv_img_set_src", "").lstrip("&")
+        if src:
+            users.setdefault(src, []).append(name)
+
+    jobs, skipped = [], []
+    for img, names in sorted(users.items()):
+        if img in imgset_members:
+            continue
+        src = read_image(ui_dir, img)
+        if src is None:
+            skipped.append((img, "colour format not handled"))
+            continue
+        data, w, h, cf = src
+        zooms = {int(objects[n].get("lv_img_set_zoom", "256")) for n in names}
+        zoom = 256
+        if zooms != {256}:
+            bad = [n for n in names if not objects[n]["on_screen"] or "lv_img_set_angle" in objects[n] or
+                   "lv_img_set_pivot" in objects[n] or objects[n].get("lv_obj_set_align") != "LV_ALIGN_CENTER"]
+            if len(zooms) > 1 or max(zooms) > 256:
+                skipped.append((img, "not pre-scaled: shown at several zooms or enlarged"))
+            elif bad:
+                skipped.append((img, "not pre-scaled: %s not centred on a screen or rotated" % ", ".join(bad)))
+            else:
+                zoom = zooms.pop()
+        dw, dh = max(1, (w * zoom + 128) >> 8), max(1, (h * zoom + 128) >> 8)
+        new_cf, new_data, recolor = smallest(resample(decode(data, cf), w, h, dw, dh), dw)
+        if zoom == 256 and len(new_data) >= len(data):
+            continue
+
+        fixups = []
+        for n in names:
+            o = objects[n]
+            if zoom == 256:
+                if recolor is not None:
+                    fixups.append((n, 0, 0))
+                continue
+            # Where LVGL draws the zoomed image: around the pivot, the
+            # centre of the full-size image, from the object's top left
+            ow = axis(o.get("lv_obj_set_width"), w, screen_w)
+            oh = axis(o.get("lv_obj_set_height"), h, screen_h)
+            cx = c_div(screen_w - ow, 2) + int(o.get("lv_obj_set_x", "0")) + w // 2
+            cy = c_div(screen_h - oh, 2) + int(o.get("lv_obj_set_y", "0")) + h // 2
+            # Same centre for the small image, object sized to it
+            fixups.append((n, cx - dw // 2 - c_div(screen_w - dw, 2), cy - dh // 2 - c_div(screen_h - dh, 2)))
+        jobs.append({"img": img, "cf": cf, "w": w, "h": h, "zoom": zoom, "dw": dw, "dh": dh, "new_cf": new_cf,
+                     "data": new_data, "recolor": recolor, "raw": len(data), "fixups": fixups})
+    return jobs, skipped
+
+
+def c_bytes(data, indent="    ", per_line=24):
+    return "\n".join(indent + ",".join("0x%02X" % b for b in data[i:i + per_line]) + ","
+                     for i in range(0, len(data), per_line))
+
+
+def short(cf):
+    return cf.replace("LV_IMG_CF_", "")
+
+
+def write_c(path, ui_dir, jobs):
+    out = ["// File: src/screen/prescaled_assets.c",
+           "// Generated by tools/prescale_assets.py from %s, do not edit." % ui_dir,
+           "// Images at the size the screens draw them, in the smallest exact",
+           "// colour format; the originals are left out of the build (platformio.ini).",
+           '#include "prescale.h"',
+           '#include "ui/ui.h"',
+           ""]
+    for j in jobs:
+        out.append("// %dx%d %s at zoom %d -> %dx%d %s" % (j["w"], j["h"], short(j["cf"]), j["zoom"], j["dw"], j["dh"],
+                                                       short(j["new_cf"])))
+        out.append("static const uint8_t %s_data[] = {" % j["img"])
+        out.append(c_bytes(j["data"]))
+        out.append("};")
+        out.append("const lv_img_dsc_t %s = {" % j["img"])
+        out.append("    .header.always_zero = 0,")
+        out.append("    .header.w = %d," % j["dw"])
+        out.append("    .header.h = %d," % j["dh"])
+        out.append("    .data_size = sizeof(%s_data)," % j["img"])
+        out.append("    .header.cf = %s," % j["new_cf"])
+        out.append("    .data = %s_data," % j["img"])
+        out.append("};")
+        out.append("")
+    out.append("const prescale_fixup_t prescale_fixups[] = {")
+    for j in jobs:
+        for obj, x, y in j["fixups"]:
+            rgb = expand565(j["recolor"]) if j["recolor"] is not None else (0, 0, 0)
+            out.append("    {&%s, &%s, %d, %d, %d, 0x%02X%02X%02X}," % ((obj, j["img"], j["zoom"], x, y) + rgb))
+    if not any(j["fixups"] for j in jobs):
+        out.append("    {NULL, NULL, 0, 0, 0, 0},")
+    out.append("};")
+    out.append("const uint16_t prescale_fixup_count = %d;" % sum(len(j["fixups"]) for j in jobs))
+    out.append("")
+    with open(path, "w") as f:
+        f.write("\n".join(out))
+
+
+def main():
+    ap = argparse.ArgumentParser(description="Pre-scale images the SquareLine screens zoom down")
+    ap.add_argument("--ui", default="src/screen/ui", help="SquareLine export directory")
+    ap.add_argument("--out", default="src/screen/prescaled_assets.c")
+    ap.add_argument("--ini", default="platformio.ini")
+    ap.add_argument("--screen", default="480x272", help="display size, WxH")
+    args = ap.parse_args()
+    screen_w, screen_h = (int(v) for v in args.screen.split("x"))
+
+    ui_c = open(os.path.join(args.ui, "ui.c")).read()
+    imgset_members = set(IMG_RE.findall(" ".join(re.findall(r"ui_imgset_\w+\s*\[\d+\]\s*=\s*\{([^}]*)\}", ui_c))))
+    jobs, skipped = plan(parse_screens(args.ui), imgset_members, args.ui, screen_w, screen_h)
+    write_c(args.out, args.ui, jobs)
+
+    # Flash budget: every still image the screens link, and what it was
+    print("%-24s %9s %-32s %9s %9s %9s" % ("image", "shown", "format", "before", "after", "saved"))
+    before = after = unzoomed = 0
+    for j in jobs:
+        before += j["raw"]
+        after += len(j["data"])
+        print("%-24s %4dx%-4d %-32s %9d %9d %9d" % (j["img"], j["dw"], j["dh"], short(j["cf"]) + " -> " + short(
+            j["new_cf"]), j["raw"], len(j["data"]), j["raw"] - len(j["data"])))
+        if j["zoom"] != 256:
+            unzoomed += j["dw"] * j["dh"]
+            print("%-24s %d px per draw copied, were zoomed down from %dx%d" % ("", j["dw"] * j["dh"], j["w"], j["h"]))
+    regenerated = {j["img"] for j in jobs}
+    for path in sorted(glob.glob(os.path.join(args.ui, "ui_img_*.c"))):
+        img = os.path.basename(path)[:-2]
+        src = None if img in regenerated or img in imgset_members else read_image(args.ui, img)
+        if src is not None:
+            before += len(src[0])
+            after += len(src[0])
+            print("%-24s %4dx%-4d %-32s %9d %9d %9d" % (img, src[1], src[2], short(src[3]), len(src[0]), len(src[0]),
+                                                        0))
+    for img, why in skipped:
+        print("%-24s %s" % (img, why))
+    print("Total %d -> %d bytes, %d saved (image sets are in the asset pack, see pack_assets.py)" %
+          (before, after, before - after))
+    if unzoomed:
+        print("Draw: %d px per redraw of every screen no longer zoomed (pixels, not time: "
+              "the screen-native simulator times boot.sim)" % unzoomed)
+
+    ini = open(args.ini).read()
+    missing = [j["img"] for j in jobs if "-<screen/ui/%s.c>" % j["img"] not in ini]
+    if missing:
+        sys.exit("add -<screen/ui/%s.c> to the screen build_src_filter lines in %s" %
+                 (".c> -<screen/ui/".join(missing), args.ini))
+
+
+if __name__ == "__main__":
+    main()